@@ -0,0 +1,15 @@
+#ifndef BANDED_H
+#define BANDED_H
+
+#include "renderer.h"
+
+// Render a wireframe straight to a PPM (or PGM if the filename ends in ".pgm")
+// one horizontal band at a time. Only the edges binned to a band are
+// rasterized into a band_height-row buffer, and finished rows are written in
+// order, so peak memory follows the band height rather than the image size.
+// Output matches rendering the full canvas and saving it.
+// Returns 1 on success, 0 on failure.
+int render_wireframe_banded(const char* filename, int width, int height, int band_height,
+                            mesh_t* mesh, mat4_t transform, const render_setup_t* setup);
+
+#endif
@@ -0,0 +1,48 @@
+#ifndef BVH_H
+#define BVH_H
+
+#include "canvas.h"
+#include "math3d.h"
+#include "renderer.h"
+
+#define BVH_LEAF_SIZE 4
+
+typedef struct {
+    float min[3], max[3]; // Bounds of all edges below this node (mesh space)
+    int first;            // Inner: index of left child (right is first + 1). Leaf: first slot in edge_index
+    int count;            // Edges in leaf, 0 for inner nodes
+} bvh_node_t;
+
+typedef struct {
+    bvh_node_t* nodes;    // Flat depth-first node array, root at 0
+    int node_count;
+    int* edge_index;      // Leaf slots -> mesh edge index
+    int edge_count;
+
+    // Per-frame projection cache used by render_wireframe_bvh
+    float* projected;     // Packed xyz per vertex
+    unsigned* stamp;      // Frame stamp per vertex, valid when == frame
+    unsigned frame;
+    int vertex_count;
+} edge_bvh_t;
+
+// Build / free (the mesh must not change while the BVH is in use)
+edge_bvh_t build_edge_bvh(const mesh_t* mesh);
+void free_edge_bvh(edge_bvh_t* bvh);
+
+// Collect edges whose node bounds project into the screen rectangle [x0,x1]x[y0,y1]
+int edge_bvh_query_rect(edge_bvh_t* bvh, canvas_t* canvas, mat4_t transform,
+                        float x0, float y0, float x1, float y1,
+                        int* out_edges, int max_edges);
+
+// Wireframe render that only transforms and draws edges in visible nodes.
+// Unlike render_wireframe, the mesh vertices are left untouched.
+void render_wireframe_bvh(canvas_t* canvas, mesh_t* mesh, edge_bvh_t* bvh, mat4_t transform);
+
+// Picking in mesh space. Return the nearest edge index (or -1) within max_dist.
+int edge_bvh_pick_ray(const edge_bvh_t* bvh, const mesh_t* mesh, vec3_t origin, vec3_t dir,
+                      float max_dist, float* out_dist);
+int edge_bvh_pick_point(const edge_bvh_t* bvh, const mesh_t* mesh, vec3_t point,
+                        float max_dist, float* out_dist);
+
+#endif
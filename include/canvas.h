@@ -1,17 +1,84 @@
-#ifndef CANVAS_H
-#define CANVAS_H
-
-typedef struct {
-    int width;
-    int height;
-    float** pixels; // 2D array: brightness at each pixel [0.0 to 1.0]
-} canvas_t;
-
-// Function declarations
-canvas_t* create_canvas(int width, int height);
-void free_canvas(canvas_t* canvas);
-void set_pixel_f(canvas_t* canvas, float x, float y, float intensity);
-void draw_line_f(canvas_t* canvas, float x0, float y0, float x1, float y1, float thickness);
-void save_canvas_as_ppm(canvas_t* canvas, const char* filename);
-
+#ifndef CANVAS_H
+#define CANVAS_H
+
+#include <stddef.h>
+
+#define CANVAS_TILE_SIZE 32
+
+// Free list of CANVAS_TILE_SIZE x CANVAS_TILE_SIZE float tiles, shareable by
+// many sparse canvases (not thread-safe)
+typedef struct {
+    float** free_tiles;
+    int free_count;
+    int free_capacity;
+    int allocated; // Tiles ever taken from the system
+    int in_use;    // Tiles currently held by canvases
+} tile_pool_t;
+
+typedef struct {
+    int width;
+    int height;
+    float** pixels; // 2D array: brightness at each pixel [0.0 to 1.0] (NULL for sparse canvases)
+    float** depth;  // Optional depth buffer (NULL until canvas_enable_depth), smaller z is nearer
+
+    // Sparse canvases: tiles are allocated on first write, a NULL tile reads as zero
+    float** tiles;  // tiles_x * tiles_y, row-major
+    int tiles_x;
+    int tiles_y;
+    tile_pool_t* pool;
+    int owns_pool;
+
+    int external;   // Pixel rows point into caller memory, which free_canvas leaves alone
+} canvas_t;
+
+typedef enum {
+    CANVAS_FORMAT_F32 // One native float per pixel, the canvas' working format
+} canvas_format_t;
+
+// Function declarations
+canvas_t* create_canvas(int width, int height);
+void free_canvas(canvas_t* canvas);
+
+// Sparse canvas drawing from pool (NULL gives the canvas a private pool). Memory
+// and clear_canvas(canvas, 0) cost follow the tiles actually drawn on. Its
+// pixels is NULL, so read it with canvas_row() or canvas_pixel_ptr(). Drawing,
+// PPM/T3Z output and layer sources accept sparse canvases; layer_stack_composite()
+// rejects one as its output.
+canvas_t* create_sparse_canvas(int width, int height, tile_pool_t* pool);
+tile_pool_t* create_tile_pool();
+void free_tile_pool(tile_pool_t* pool); // Free canvases using the pool first
+
+// Wrap caller memory: row y starts at memory + y * stride bytes. The memory must
+// outlive the canvas. Returns NULL for an unsupported format, misaligned memory
+// or a stride shorter than a row.
+canvas_t* create_canvas_external(void* memory, int width, int height, size_t stride, canvas_format_t format);
+
+// Writable pointer to pixel (x, y), valid through the end of its tile row on a
+// sparse canvas (allocating the tile) or the end of the row on a dense one
+float* canvas_pixel_ptr(canvas_t* canvas, int x, int y);
+
+// Read-only row y. Sparse canvases assemble it into scratch (width floats);
+// dense canvases return their own row and never touch scratch.
+const float* canvas_row(canvas_t* canvas, int y, float* scratch);
+
+void set_pixel_f(canvas_t* canvas, float x, float y, float intensity);
+void draw_line_f(canvas_t* canvas, float x0, float y0, float x1, float y1, float thickness);
+void draw_line_fi(canvas_t* canvas, float x0, float y0, float x1, float y1, float thickness, float intensity);
+// draw_line_f limited to the samples that can reach rows [row_begin, row_end).
+// Those rows come out exactly as draw_line_f would draw them.
+void draw_line_rows_f(canvas_t* canvas, float x0, float y0, float x1, float y1, float thickness,
+                      int row_begin, int row_end);
+void draw_polyline_f(canvas_t* canvas, const float* xy, int point_count, const float* thickness);
+void clear_canvas(canvas_t* canvas, float value);
+void save_canvas_as_ppm(canvas_t* canvas, const char* filename);
+size_t canvas_ppm_size(canvas_t* canvas);
+size_t encode_canvas_as_ppm(canvas_t* canvas, unsigned char* out);
+
+// Depth buffer
+void canvas_enable_depth(canvas_t* canvas);
+void clear_depth(canvas_t* canvas);
+void set_pixel_depth_f(canvas_t* canvas, float x, float y, float z, float intensity, float bias);
+void draw_line_depth_f(canvas_t* canvas, float x0, float y0, float z0,
+                       float x1, float y1, float z1, float thickness, float bias);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,39 @@
+#ifndef DISPLAYLIST_H
+#define DISPLAYLIST_H
+
+#include "renderer.h"
+
+// One recorded edge, in projected coordinates so it can be replayed at any
+// canvas size. Viewport clipping and thickness are applied at replay time.
+typedef struct {
+    float x0, y0, x1, y1; // Projected (post-divide) endpoints
+    float brightness;     // Edge lighting evaluated when recorded
+} display_segment_t;
+
+typedef struct {
+    display_segment_t* segments;
+    int count;
+    int capacity;
+} display_list_t;
+
+display_list_t* create_display_list();
+void free_display_list(display_list_t* list);
+void clear_display_list(display_list_t* list);
+
+// Project and light every edge of the mesh (mesh left untouched) and append it
+void display_list_record(display_list_t* list, mesh_t* mesh, mat4_t transform);
+
+// Reorder segments along a Z-order curve of their midpoints for rasterizer locality
+void display_list_sort(display_list_t* list);
+
+// Rasterize into any canvas with the config's viewport and thickness rules and an
+// intensity scale. With config.lighting == 0 recorded brightness is ignored.
+// render_config_default() and intensity 1 reproduce render_wireframe_with().
+void display_list_replay(canvas_t* canvas, const display_list_t* list,
+                         const render_config_t* config, float intensity);
+
+// Binary file round trip (native float layout). Save returns 1 on success, load NULL on failure.
+int save_display_list(const display_list_t* list, const char* filename);
+display_list_t* load_display_list(const char* filename);
+
+#endif
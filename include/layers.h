@@ -0,0 +1,55 @@
+#ifndef LAYERS_H
+#define LAYERS_H
+
+#include "canvas.h"
+
+#define LAYER_STACK_MAX 16
+#define LAYER_NAME_MAX 32
+
+typedef enum {
+    BLEND_ADD,  // dst + src * opacity
+    BLEND_MAX,  // max(dst, src * opacity)
+    BLEND_OVER  // src over dst, with min(src, 1) * opacity as coverage
+} blend_mode_t;
+
+typedef struct {
+    char name[LAYER_NAME_MAX];
+    canvas_t* canvas;
+    blend_mode_t blend;
+    float opacity;
+    int is_static; // Drawn once; kept in the cached base while it stays at the bottom
+} layer_t;
+
+// Layers are composited bottom (index 0) to top onto a black output. The
+// leading run of static layers is flattened once into a cached base, so a frame
+// costs its dynamic drawing plus one copy and one blend pass per dynamic layer.
+typedef struct {
+    int width;
+    int height;
+    layer_t layers[LAYER_STACK_MAX];
+    int count;
+    canvas_t* base;   // Composite of layers[0 .. static_prefix)
+    int static_prefix;
+    int base_valid;
+    float* row_scratch; // One row, for reading sparse layer canvases
+} layer_stack_t;
+
+layer_stack_t* create_layer_stack(int width, int height);
+void free_layer_stack(layer_stack_t* stack);
+
+// Append a cleared layer on top. Returns NULL if the stack is full.
+layer_t* layer_stack_add(layer_stack_t* stack, const char* name, blend_mode_t blend, int is_static);
+layer_t* layer_stack_find(layer_stack_t* stack, const char* name);
+
+// Call after redrawing a static layer or changing any layer's blend, opacity or static flag
+void layer_stack_invalidate(layer_stack_t* stack);
+
+// Clear every dynamic layer to 0 ready for the next frame
+void layer_stack_clear_dynamic(layer_stack_t* stack);
+
+// Flatten the stack into out, a dense canvas matching the stack size. Layer
+// canvases may be swapped for sparse ones of the same size. Returns 0 without
+// touching out if out is sparse or the wrong size.
+int layer_stack_composite(layer_stack_t* stack, canvas_t* out);
+
+#endif
@@ -0,0 +1,22 @@
+#ifndef MESH_OPT_H
+#define MESH_OPT_H
+
+#include "renderer.h"
+
+typedef struct {
+    float edge_span_before;   // Average |v0 - v1| over all edges
+    float edge_span_after;
+    float edge_jump_before;   // Average index distance between consecutive edges
+    float edge_jump_after;
+} mesh_locality_t;
+
+// Average index distances of a mesh as it is currently ordered
+void mesh_measure_locality(const mesh_t* mesh, float* edge_span, float* edge_jump);
+
+// Renumber vertices in traversal order (Morton-seeded BFS over the edge graph).
+// With reorder_edges != 0, edges are also sorted so neighbours share vertices;
+// this only changes the order lines are accumulated into the canvas.
+// Edge orientation (v0 -> v1) is preserved so lighting is unchanged.
+mesh_locality_t mesh_optimize_locality(mesh_t* mesh, int reorder_edges);
+
+#endif
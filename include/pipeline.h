@@ -0,0 +1,52 @@
+#ifndef PIPELINE_H
+#define PIPELINE_H
+
+#include <stdatomic.h>
+#include <pthread.h>
+#include "canvas.h"
+
+#define PIPELINE_MAX_FRAMES 16
+#define PIPELINE_FILENAME_MAX 256
+
+// Single-producer / single-consumer lock-free ring of slot indices
+typedef struct {
+    _Alignas(64) atomic_uint head; // Advanced by the consumer
+    _Alignas(64) atomic_uint tail; // Advanced by the producer
+    int slots[PIPELINE_MAX_FRAMES];
+} spsc_ring_t;
+
+typedef struct {
+    canvas_t* canvas;
+    char filename[PIPELINE_FILENAME_MAX];
+} frame_slot_t;
+
+typedef struct {
+    frame_slot_t frames[PIPELINE_MAX_FRAMES]; // Preallocated canvas pool
+    int frame_count;
+    spsc_ring_t free_ring;  // writer -> renderer: canvases ready for reuse
+    spsc_ring_t full_ring;  // renderer -> writer: canvases ready to encode
+    unsigned char* encode_buffer; // Writer-owned, sized for one PPM or T3Z frame
+    atomic_int running;
+    pthread_t writer;
+
+    // Stats
+    atomic_uint frames_written;
+    atomic_uint render_stalls;  // acquire() found no free canvas
+    atomic_uint write_errors;
+} frame_pipeline_t;
+
+// Start a writer thread with pool_size canvases (2..PIPELINE_MAX_FRAMES)
+frame_pipeline_t* frame_pipeline_create(int width, int height, int pool_size);
+
+// Take a canvas from the pool (waits while all canvases are queued for writing).
+// The canvas keeps its previous contents; clear it before drawing.
+canvas_t* frame_pipeline_acquire(frame_pipeline_t* pipeline);
+
+// Hand a finished canvas to the writer thread; it is returned to the pool once written.
+// Filenames ending in ".t3z" are written as T3Z, anything else as PPM.
+void frame_pipeline_submit(frame_pipeline_t* pipeline, canvas_t* canvas, const char* filename);
+
+// Flush every submitted frame, stop the writer and free the pool
+void frame_pipeline_destroy(frame_pipeline_t* pipeline);
+
+#endif
@@ -0,0 +1,22 @@
+#ifndef RASTER_H
+#define RASTER_H
+
+#include "canvas.h"
+
+#define RASTER_BLOCK 8 // Triangles are walked in 8x8 pixel blocks
+
+// Depth-only triangle fill (screen-space x/y, post-divide z). Keeps the nearest z.
+void rasterize_triangle_depth(canvas_t* canvas,
+                              float x0, float y0, float z0,
+                              float x1, float y1, float z1,
+                              float x2, float y2, float z2);
+
+// Solid triangle fill with a constant intensity. When the canvas has a depth
+// buffer the fill is depth-tested and writes depth; otherwise it overwrites.
+void fill_triangle_f(canvas_t* canvas,
+                     float x0, float y0, float z0,
+                     float x1, float y1, float z1,
+                     float x2, float y2, float z2,
+                     float intensity);
+
+#endif
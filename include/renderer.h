@@ -1,37 +1,101 @@
-#ifndef RENDERER_H
-#define RENDERER_H
-
-#include "canvas.h"
-#include "math3d.h"
-
-typedef struct {
-    vec3_t position;
-    float intensity; // For lighting (0.0 to 1.0)
-} vertex_t;
-
-typedef struct {
-    int v0, v1; // Vertex indices
-    float depth; // Average depth for sorting
-} edge_t;
-
-typedef struct {
-    vertex_t* vertices;
-    int vertex_count;
-    edge_t* edges;
-    int edge_count;
-} mesh_t;
-
-
-// Rendering functions
-mesh_t create_cube_mesh(float size);
-mesh_t load_obj_mesh(const char* filename);
-void project_vertex(vertex_t* vertex, mat4_t transform);
-int clip_to_circular_viewport(canvas_t* canvas, float x, float y);
-void render_wireframe(canvas_t* canvas, mesh_t* mesh, mat4_t transform);
-mesh_t generate_soccer_ball(float radius);
-
-// Mesh utilities
-mesh_t create_cube_mesh(float size);
-void free_mesh(mesh_t* mesh);
-
+#ifndef RENDERER_H
+#define RENDERER_H
+
+#include "canvas.h"
+#include "math3d.h"
+#include "lighting.h"
+
+typedef struct {
+    vec3_t position;
+    float intensity; // For lighting (0.0 to 1.0)
+} vertex_t;
+
+typedef struct {
+    int v0, v1; // Vertex indices
+    float depth; // Average depth for sorting
+} edge_t;
+
+typedef struct {
+    int v0, v1, v2; // Triangle vertex indices (polygons are fan-triangulated)
+} face_t;
+
+// free_mesh() frees all three arrays, so build meshes from mesh_t mesh = {0}
+// and leave faces NULL unless the mesh owns a malloc'd face array.
+typedef struct {
+    vertex_t* vertices;
+    int vertex_count;
+    edge_t* edges;
+    int edge_count;
+    face_t* faces;  // Optional, NULL when the mesh is edges only (owned otherwise)
+    int face_count;
+} mesh_t;
+
+#define LINE_DEPTH_BIAS 0.002f // Keeps edges from being hidden by their own faces
+
+// Wireframe options, resolved once by render_setup() into a specialized edge loop
+typedef enum {
+    VIEWPORT_NONE,   // Draw every edge
+    VIEWPORT_RECT,   // Both endpoints inside [rect_x0, rect_x1] x [rect_y0, rect_y1]
+    VIEWPORT_CIRCLE  // Both endpoints inside the circular viewport (clip_to_circular_viewport)
+} viewport_mode_t;
+
+typedef struct {
+    int lighting;            // Lambert brightness per edge from the scene light
+    viewport_mode_t viewport;
+    float rect_x0, rect_y0, rect_x1, rect_y1;
+    int variable_thickness;  // Thickness = thickness * brightness instead of a constant
+    float thickness;
+} render_config_t;
+
+typedef void (*edge_loop_fn)(canvas_t* canvas, const float* xyz, const edge_t* edges, int count,
+                             const render_config_t* config);
+
+// Edge loop taking per-edge brightness computed elsewhere
+typedef void (*shaded_edge_loop_fn)(canvas_t* canvas, const float* xyz, const edge_t* edges, int count,
+                                    const float* shade, const render_config_t* config);
+
+typedef struct {
+    render_config_t config;
+    edge_loop_fn loop;
+    shaded_edge_loop_fn shaded_loop; // NULL when lighting is off
+} render_setup_t;
+
+// One camera of a multi-view render
+typedef struct {
+    canvas_t* canvas;
+    mat4_t view_projection; // World space -> projected
+} render_view_t;
+
+#define RENDER_VIEW_BATCH 256 // Vertices projected through every view before moving on
+
+// Options equivalent to render_wireframe (lighting, circular viewport, 1.5 * brightness)
+render_config_t render_config_default();
+render_setup_t render_setup(render_config_t config);
+
+
+// Rendering functions
+mesh_t create_cube_mesh(float size);
+mesh_t load_obj_mesh(const char* filename);
+mesh_t load_obj_mesh_parallel(const char* filename, int thread_count); // thread_count <= 0: all cores
+void project_vertex(vertex_t* vertex, mat4_t transform);
+int clip_to_circular_viewport(canvas_t* canvas, float x, float y);
+void ndc_to_screen(canvas_t* canvas, float nx, float ny, float* sx, float* sy);
+float compute_edge_brightness(vec3_t edge_dir);
+void render_wireframe(canvas_t* canvas, mesh_t* mesh, mat4_t transform);
+void render_wireframe_with(canvas_t* canvas, mesh_t* mesh, mat4_t transform, const render_setup_t* setup);
+void render_edges(canvas_t* canvas, const render_setup_t* setup, const float* xyz,
+                  const edge_t* edges, int count);
+float compute_edge_brightness_xyz(const float* p0, const float* p1);
+void render_wireframe_views(mesh_t* mesh, mat4_t model, const render_view_t* views, int view_count,
+                            const render_setup_t* setup);
+int render_obj_streaming(canvas_t* canvas, const char* filename, mat4_t transform,
+                         const render_setup_t* setup, int chunk_edges);
+void render_wireframe_hidden(canvas_t* canvas, mesh_t* mesh, mat4_t transform);
+void render_solid(canvas_t* canvas, mesh_t* mesh, mat4_t transform, light_t* lights, int light_count);
+mesh_t generate_soccer_ball(float radius);
+
+// Mesh utilities
+mesh_t create_cube_mesh(float size);
+void free_mesh(mesh_t* mesh);
+
 #endif
\ No newline at end of file
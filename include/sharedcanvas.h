@@ -0,0 +1,72 @@
+#ifndef SHAREDCANVAS_H
+#define SHAREDCANVAS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include "canvas.h"
+
+#define SHARED_CANVAS_MAGIC 0x43533354u // "T3SC" in memory order
+#define SHARED_CANVAS_HEADER_SIZE 64    // Buffers start here, cache-line aligned
+#define SHARED_CANVAS_BUFFERS 3         // Published, being drawn, and one spare for a slow reader
+
+// Start of the shared mapping, followed by SHARED_CANVAS_BUFFERS pixel buffers.
+// Buffer i's float rows are at SHARED_CANVAS_HEADER_SIZE + (i * height + y) * stride.
+//
+// Protocol (one producer, any number of readers in any process):
+//   - The producer draws only into a buffer that is neither `ready` nor held by
+//     a reader, then publishes it: buffer_frame[b] = n, ready = b (release),
+//     frame = n. A published buffer is never written again until it has been
+//     replaced as `ready` and its reader count is back to 0.
+//   - A reader loads ready (acquire), increments readers[ready], and checks that
+//     ready is unchanged; if it changed it decrements and retries. While held,
+//     the buffer holds exactly one finished frame.
+typedef struct {
+    uint32_t magic;
+    uint32_t width;
+    uint32_t height;
+    uint32_t stride;        // Bytes per row
+    uint32_t format;        // canvas_format_t
+    uint32_t buffer_count;  // SHARED_CANVAS_BUFFERS
+    atomic_uint frame;      // Latest published frame number (0 before the first publish)
+    atomic_uint ready;      // Buffer holding that frame
+    atomic_uint readers[SHARED_CANVAS_BUFFERS]; // Readers currently holding each buffer
+    uint32_t buffer_frame[SHARED_CANVAS_BUFFERS]; // Frame number drawn into each buffer
+} shared_canvas_header_t;
+
+typedef struct {
+    canvas_t* buffers[SHARED_CANVAS_BUFFERS]; // Each draws straight into the mapping
+    shared_canvas_header_t* header;
+    void* mapping;
+    size_t size;
+    int fd;                 // Hand to the consumer (fork, SCM_RIGHTS or /proc/<pid>/fd/<fd>)
+    int owns_fd;
+    int drawing;            // Producer: buffer handed out by shared_canvas_begin_frame, or -1
+    int held;               // Reader: buffer held by shared_canvas_acquire, or -1
+} shared_canvas_t;
+
+// Back a new triple-buffered canvas with an anonymous memfd named name (for /proc listings)
+shared_canvas_t* create_shared_canvas(int width, int height, const char* name);
+
+// Map a shared canvas created by another process from its fd (the fd stays the caller's)
+shared_canvas_t* open_shared_canvas(int fd);
+
+// Producer: a buffer no reader can see, to clear and draw the next frame into.
+// Its contents are stale (an older frame). Waits while readers hold every spare buffer.
+canvas_t* shared_canvas_begin_frame(shared_canvas_t* shared);
+
+// Producer: publish the buffer from begin_frame as the latest finished frame;
+// returns the new frame number
+unsigned shared_canvas_publish(shared_canvas_t* shared);
+
+// Reader: hold the latest finished frame until shared_canvas_release(). The
+// producer never writes a held buffer. Stores its frame number in *frame if non-NULL.
+const canvas_t* shared_canvas_acquire(shared_canvas_t* shared, unsigned* frame);
+void shared_canvas_release(shared_canvas_t* shared);
+
+// Latest published frame number (0 before the first publish), for polling
+unsigned shared_canvas_frame(const shared_canvas_t* shared);
+
+void free_shared_canvas(shared_canvas_t* shared); // Releases a held buffer
+
+#endif
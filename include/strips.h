@@ -0,0 +1,29 @@
+#ifndef STRIPS_H
+#define STRIPS_H
+
+#include "renderer.h"
+
+// A mesh's edge set as polylines. Duplicate edges (either orientation) and
+// degenerate edges are dropped, then connected edges are chained with
+// Euler-path style walks that start from odd-degree vertices.
+typedef struct {
+    int* indices;           // Concatenated strip vertex indices
+    unsigned char* reversed; // reversed[j]: segment indices[j-1] -> indices[j] runs against the mesh edge
+    int* starts;            // Strip k is indices[starts[k] .. starts[k + 1])
+    int strip_count;
+    int index_count;
+    int edge_count;         // Unique edges covered (segments)
+    int duplicates_removed; // Duplicate and degenerate mesh edges dropped
+} edge_strips_t;
+
+edge_strips_t* build_edge_strips(const mesh_t* mesh);
+void free_edge_strips(edge_strips_t* strips);
+
+// Draw the strips with the setup's viewport, lighting and thickness options.
+// Each vertex is projected once and joints between visible segments are
+// splatted once. Lighting uses each edge's original v0 -> v1 direction, so a
+// mesh without duplicate edges is lit as by render_wireframe_with().
+void render_edge_strips(canvas_t* canvas, const edge_strips_t* strips, mesh_t* mesh,
+                        mat4_t transform, const render_setup_t* setup);
+
+#endif
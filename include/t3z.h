@@ -0,0 +1,42 @@
+#ifndef T3Z_H
+#define T3Z_H
+
+#include <stddef.h>
+#include "canvas.h"
+
+// T3Z: lossless 8-bit grayscale frames for mostly-black wireframe output.
+//
+// Pixels are quantized exactly as in save_canvas_as_ppm and coded row-major as a
+// byte stream of ops, each predicting from the previous pixel (0 at the start):
+//   00rrrrrr            run of r+1 zero pixels
+//   01dddddd            one pixel, previous + (d - 32)
+//   10rrrrrr            previous pixel repeated r+1 times
+//   11000000 <varint>   run of varint+1 zero pixels
+//   11000001 <varint>   previous pixel repeated varint+1 times
+//   11nnnnnn <n-1 bytes> literal pixels, for n >= 2 (1..62 bytes)
+// after a 12-byte header: "T3Z1", then width and height as little-endian uint32.
+
+#define T3Z_EXTENSION ".t3z"
+#define T3Z_MAX_DIMENSION 65536 // Largest width or height either direction accepts
+
+// Upper bound on encode_canvas_as_t3z output for a canvas
+size_t canvas_t3z_max_size(canvas_t* canvas);
+
+// Encode into out (canvas_t3z_max_size() bytes); returns the encoded size, or 0
+// for a canvas wider or taller than T3Z_MAX_DIMENSION
+size_t encode_canvas_as_t3z(canvas_t* canvas, unsigned char* out);
+
+void save_canvas_as_t3z(canvas_t* canvas, const char* filename);
+
+// Decode to a malloc'd width*height array of 8-bit pixels. Returns NULL on malformed
+// input, including ops that do not cover exactly width*height pixels (checked
+// before anything is allocated).
+unsigned char* decode_t3z(const unsigned char* data, size_t size, int* width, int* height);
+
+// Read a .t3z file into a new canvas (pixels scaled back to 0..1). NULL on failure.
+canvas_t* load_canvas_t3z(const char* filename);
+
+// 1 if filename ends in ".t3z"
+int is_t3z_filename(const char* filename);
+
+#endif
@@ -1,12 +1,24 @@
-#ifndef TINY3D_H
-#define TINY3D_H
-
-// Include all other header files to create a master header
-#include "canvas.h"
-#include "math3d.h"
-#include "renderer.h"
-#include "lighting.h"
-
-
-
-#endif // TINY3D_H
+#ifndef TINY3D_H
+#define TINY3D_H
+
+// Include all other header files to create a master header
+#include "canvas.h"
+#include "math3d.h"
+#include "fastmath.h"
+#include "renderer.h"
+#include "lighting.h"
+#include "raster.h"
+#include "bvh.h"
+#include "mesh_opt.h"
+#include "pipeline.h"
+#include "banded.h"
+#include "displaylist.h"
+#include "framecache.h"
+#include "layers.h"
+#include "t3z.h"
+#include "strips.h"
+#include "sharedcanvas.h"
+
+
+
+#endif // TINY3D_H
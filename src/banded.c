@@ -0,0 +1,154 @@
+#include "banded.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    float x0, y0, x1, y1;
+    float thickness;
+} band_segment_t;
+
+// Apply the setup's viewport and lighting to one projected edge (same rules as the edge loops)
+static int make_segment(canvas_t* canvas, const render_config_t* config,
+                        const float* p0, const float* p1, band_segment_t* seg) {
+    ndc_to_screen(canvas, p0[0], p0[1], &seg->x0, &seg->y0);
+    ndc_to_screen(canvas, p1[0], p1[1], &seg->x1, &seg->y1);
+
+    if (config->viewport == VIEWPORT_CIRCLE) {
+        if (!clip_to_circular_viewport(canvas, seg->x0, seg->y0) ||
+            !clip_to_circular_viewport(canvas, seg->x1, seg->y1))
+            return 0;
+    } else if (config->viewport == VIEWPORT_RECT) {
+        if (!(seg->x0 >= config->rect_x0 && seg->x0 <= config->rect_x1 &&
+              seg->y0 >= config->rect_y0 && seg->y0 <= config->rect_y1 &&
+              seg->x1 >= config->rect_x0 && seg->x1 <= config->rect_x1 &&
+              seg->y1 >= config->rect_y0 && seg->y1 <= config->rect_y1))
+            return 0;
+    }
+
+    float brightness = config->lighting ? compute_edge_brightness_xyz(p0, p1) : 1.0f;
+    seg->thickness = config->variable_thickness ? config->thickness * brightness : config->thickness;
+    return 1;
+}
+
+static void write_band_rows(FILE* file, canvas_t* band, int y_begin, int y_end,
+                            unsigned char* row_bytes, int channels) {
+    for (int y = y_begin; y < y_end; y++) {
+        const float* row = band->pixels[y];
+        for (int x = 0; x < band->width; x++) {
+            unsigned char value = (unsigned char)(fminf(row[x], 1.0f) * 255);
+            for (int c = 0; c < channels; c++) row_bytes[x * channels + c] = value;
+        }
+        fwrite(row_bytes, 1, (size_t)band->width * channels, file);
+    }
+}
+
+int render_wireframe_banded(const char* filename, int width, int height, int band_height,
+                            mesh_t* mesh, mat4_t transform, const render_setup_t* setup) {
+    if (width <= 0 || height <= 0) {
+        fprintf(stderr, "render_wireframe_banded: invalid image size %dx%d\n", width, height);
+        return 0;
+    }
+    if (band_height < 1) band_height = 1;
+    if (band_height > height) band_height = height;
+
+    size_t name_len = strlen(filename);
+    int channels = (name_len >= 4 && strcmp(filename + name_len - 4, ".pgm") == 0) ? 1 : 3;
+
+    FILE* file = fopen(filename, "wb");
+    if (!file) {
+        perror("Failed to open file");
+        return 0;
+    }
+    fprintf(file, "%s\n%d %d\n255\n", channels == 1 ? "P5" : "P6", width, height);
+
+    // A full-height row table whose rows all point at one scratch row, except
+    // the rows of the current band. Lines keep their full-image coordinates and
+    // anything they splat outside the band lands in the scratch row.
+    canvas_t band = {0};
+    band.width = width;
+    band.height = height;
+    band.depth = NULL;
+    band.pixels = malloc(sizeof(float*) * height);
+    float* band_memory = malloc(sizeof(float) * (size_t)width * band_height);
+    float* scratch_row = malloc(sizeof(float) * width);
+    unsigned char* row_bytes = malloc((size_t)width * channels);
+    for (int y = 0; y < height; y++) band.pixels[y] = scratch_row;
+
+    // Project and clip once; the segment list scales with the mesh, not the image
+    float* xyz = malloc(sizeof(float) * 3 * (mesh->vertex_count > 0 ? mesh->vertex_count : 1));
+    for (int i = 0; i < mesh->vertex_count; i++) {
+        vec3_t p = mesh->vertices[i].position;
+        float in[3] = { p.x, p.y, p.z };
+        mat4_transform_point(transform, in, &xyz[i * 3]);
+    }
+
+    band_segment_t* segments = malloc(sizeof(band_segment_t) * (mesh->edge_count > 0 ? mesh->edge_count : 1));
+    int* first_band = malloc(sizeof(int) * (mesh->edge_count > 0 ? mesh->edge_count : 1));
+    int* last_band = malloc(sizeof(int) * (mesh->edge_count > 0 ? mesh->edge_count : 1));
+    int band_count = (height + band_height - 1) / band_height;
+    int* bin_offsets = calloc(band_count + 1, sizeof(int));
+    int segment_count = 0;
+
+    for (int i = 0; i < mesh->edge_count; i++) {
+        band_segment_t* seg = &segments[segment_count];
+        if (!make_segment(&band, &setup->config, &xyz[mesh->edges[i].v0 * 3],
+                          &xyz[mesh->edges[i].v1 * 3], seg))
+            continue;
+
+        // Rows a line can touch: its extent, half the thickness, and the bilinear neighbour
+        float reach = seg->thickness / 2.0f + 2.0f;
+        int lo = (int)floorf((fminf(seg->y0, seg->y1) - reach) / band_height);
+        int hi = (int)floorf((fmaxf(seg->y0, seg->y1) + reach) / band_height);
+        if (hi < 0 || lo >= band_count) continue;
+        if (lo < 0) lo = 0;
+        if (hi >= band_count) hi = band_count - 1;
+
+        first_band[segment_count] = lo;
+        last_band[segment_count] = hi;
+        for (int b = lo; b <= hi; b++) bin_offsets[b + 1]++;
+        segment_count++;
+    }
+
+    // Bin segment indices per band, keeping edge order so accumulation matches a full canvas
+    for (int b = 0; b < band_count; b++) bin_offsets[b + 1] += bin_offsets[b];
+    int* bins = malloc(sizeof(int) * (bin_offsets[band_count] > 0 ? bin_offsets[band_count] : 1));
+    int* fill = malloc(sizeof(int) * band_count);
+    memcpy(fill, bin_offsets, sizeof(int) * band_count);
+    for (int s = 0; s < segment_count; s++) {
+        for (int b = first_band[s]; b <= last_band[s]; b++) bins[fill[b]++] = s;
+    }
+    free(fill);
+    free(first_band);
+    free(last_band);
+    free(xyz);
+
+    for (int b = 0; b < band_count; b++) {
+        int y_begin = b * band_height;
+        int y_end = y_begin + band_height < height ? y_begin + band_height : height;
+
+        memset(band_memory, 0, sizeof(float) * (size_t)width * band_height);
+        for (int y = y_begin; y < y_end; y++) band.pixels[y] = band_memory + (size_t)(y - y_begin) * width;
+
+        for (int k = bin_offsets[b]; k < bin_offsets[b + 1]; k++) {
+            const band_segment_t* seg = &segments[bins[k]];
+            draw_line_rows_f(&band, seg->x0, seg->y0, seg->x1, seg->y1, seg->thickness, y_begin, y_end);
+        }
+
+        write_band_rows(file, &band, y_begin, y_end, row_bytes, channels);
+        for (int y = y_begin; y < y_end; y++) band.pixels[y] = scratch_row;
+    }
+
+    int ok = !ferror(file);
+    fclose(file);
+
+    free(segments);
+    free(bins);
+    free(bin_offsets);
+    free(band.pixels);
+    free(band_memory);
+    free(scratch_row);
+    free(row_bytes);
+    return ok;
+}
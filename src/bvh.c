@@ -0,0 +1,414 @@
+#include "bvh.h"
+#include <math.h>
+#include <float.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BVH_STACK_SIZE 64
+
+// Per-edge bounds and centroid used while building
+typedef struct {
+    float min[3], max[3];
+    float c[3];
+} edge_box_t;
+
+// Partition edge_index[first..first+count) so the median centroid on `axis` lands at `first + k`
+static void select_median(int* idx, const edge_box_t* boxes, int count, int k, int axis) {
+    int lo = 0, hi = count - 1;
+    while (lo < hi) {
+        float pivot = boxes[idx[(lo + hi) / 2]].c[axis];
+        int i = lo, j = hi;
+        while (i <= j) {
+            while (boxes[idx[i]].c[axis] < pivot) i++;
+            while (boxes[idx[j]].c[axis] > pivot) j--;
+            if (i <= j) {
+                int tmp = idx[i]; idx[i] = idx[j]; idx[j] = tmp;
+                i++; j--;
+            }
+        }
+        if (k <= j) hi = j;
+        else if (k >= i) lo = i;
+        else break;
+    }
+}
+
+static void build_node(edge_bvh_t* bvh, const edge_box_t* boxes, int node, int first, int count) {
+    bvh_node_t* n = &bvh->nodes[node];
+    float cmin[3] = { FLT_MAX, FLT_MAX, FLT_MAX };
+    float cmax[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+
+    for (int a = 0; a < 3; a++) {
+        n->min[a] = FLT_MAX;
+        n->max[a] = -FLT_MAX;
+    }
+    for (int i = first; i < first + count; i++) {
+        const edge_box_t* b = &boxes[bvh->edge_index[i]];
+        for (int a = 0; a < 3; a++) {
+            n->min[a] = fminf(n->min[a], b->min[a]);
+            n->max[a] = fmaxf(n->max[a], b->max[a]);
+            cmin[a] = fminf(cmin[a], b->c[a]);
+            cmax[a] = fmaxf(cmax[a], b->c[a]);
+        }
+    }
+
+    if (count <= BVH_LEAF_SIZE) {
+        n->first = first;
+        n->count = count;
+        return;
+    }
+
+    // Median split along the widest centroid axis
+    int axis = 0;
+    for (int a = 1; a < 3; a++) {
+        if (cmax[a] - cmin[a] > cmax[axis] - cmin[axis]) axis = a;
+    }
+    int half = count / 2;
+    select_median(bvh->edge_index + first, boxes, count, half, axis);
+
+    int left = bvh->node_count;
+    bvh->node_count += 2;
+    n->first = left;
+    n->count = 0;
+    build_node(bvh, boxes, left, first, half);
+    build_node(bvh, boxes, left + 1, first + half, count - half);
+}
+
+edge_bvh_t build_edge_bvh(const mesh_t* mesh) {
+    edge_bvh_t bvh = {0};
+    if (mesh->edge_count <= 0) return bvh;
+
+    edge_box_t* boxes = malloc(sizeof(edge_box_t) * mesh->edge_count);
+    bvh.edge_index = malloc(sizeof(int) * mesh->edge_count);
+    bvh.nodes = malloc(sizeof(bvh_node_t) * (2 * mesh->edge_count - 1));
+    bvh.edge_count = mesh->edge_count;
+
+    for (int i = 0; i < mesh->edge_count; i++) {
+        vec3_t p0 = mesh->vertices[mesh->edges[i].v0].position;
+        vec3_t p1 = mesh->vertices[mesh->edges[i].v1].position;
+        float a[3] = { p0.x, p0.y, p0.z };
+        float b[3] = { p1.x, p1.y, p1.z };
+        for (int k = 0; k < 3; k++) {
+            boxes[i].min[k] = fminf(a[k], b[k]);
+            boxes[i].max[k] = fmaxf(a[k], b[k]);
+            boxes[i].c[k] = 0.5f * (a[k] + b[k]);
+        }
+        bvh.edge_index[i] = i;
+    }
+
+    bvh.node_count = 1;
+    build_node(&bvh, boxes, 0, 0, mesh->edge_count);
+
+    free(boxes);
+    return bvh;
+}
+
+void free_edge_bvh(edge_bvh_t* bvh) {
+    if (bvh) {
+        free(bvh->nodes);
+        free(bvh->edge_index);
+        free(bvh->projected);
+        free(bvh->stamp);
+        memset(bvh, 0, sizeof(*bvh));
+    }
+}
+
+enum { BOX_OUTSIDE, BOX_OVERLAPS, BOX_INSIDE };
+
+// Conservative screen-space test of a node's box against a pixel rectangle.
+// BOX_INSIDE means every edge below the node projects inside the rectangle.
+static int classify_node_rect(const bvh_node_t* n, canvas_t* canvas, mat4_t transform,
+                              float x0, float y0, float x1, float y1) {
+    float smin_x = FLT_MAX, smin_y = FLT_MAX;
+    float smax_x = -FLT_MAX, smax_y = -FLT_MAX;
+
+    for (int c = 0; c < 8; c++) {
+        float corner[3] = {
+            (c & 1) ? n->max[0] : n->min[0],
+            (c & 2) ? n->max[1] : n->min[1],
+            (c & 4) ? n->max[2] : n->min[2]
+        };
+        float p[3];
+        float w = mat4_transform_point(transform, corner, p);
+        if (w <= 1e-6f) return BOX_OVERLAPS; // Crosses the camera plane: keep it, test below
+
+        float sx, sy;
+        ndc_to_screen(canvas, p[0], p[1], &sx, &sy);
+        smin_x = fminf(smin_x, sx); smax_x = fmaxf(smax_x, sx);
+        smin_y = fminf(smin_y, sy); smax_y = fmaxf(smax_y, sy);
+    }
+
+    if (!(smax_x >= x0 && smin_x <= x1 && smax_y >= y0 && smin_y <= y1)) return BOX_OUTSIDE;
+    if (smin_x >= x0 && smax_x <= x1 && smin_y >= y0 && smax_y <= y1) return BOX_INSIDE;
+    return BOX_OVERLAPS;
+}
+
+// A subtree's leaves cover one contiguous run of edge_index slots
+static void subtree_slots(const edge_bvh_t* bvh, const bvh_node_t* n, int* begin, int* end) {
+    const bvh_node_t* left = n;
+    const bvh_node_t* right = n;
+    while (left->count == 0) left = &bvh->nodes[left->first];
+    while (right->count == 0) right = &bvh->nodes[right->first + 1];
+    *begin = left->first;
+    *end = right->first + right->count;
+}
+
+int edge_bvh_query_rect(edge_bvh_t* bvh, canvas_t* canvas, mat4_t transform,
+                        float x0, float y0, float x1, float y1,
+                        int* out_edges, int max_edges) {
+    int stack[BVH_STACK_SIZE];
+    int top = 0;
+    int found = 0;
+
+    if (bvh->node_count == 0) return 0;
+    stack[top++] = 0;
+
+    while (top > 0) {
+        const bvh_node_t* n = &bvh->nodes[stack[--top]];
+        int side = classify_node_rect(n, canvas, transform, x0, y0, x1, y1);
+        if (side == BOX_OUTSIDE) continue;
+
+        if (n->count > 0 || side == BOX_INSIDE) {
+            int begin, end;
+            subtree_slots(bvh, n, &begin, &end);
+            for (int i = begin; i < end && found < max_edges; i++) {
+                out_edges[found++] = bvh->edge_index[i];
+            }
+        } else {
+            stack[top++] = n->first + 1;
+            stack[top++] = n->first;
+        }
+    }
+    return found;
+}
+
+// Project a vertex once per frame through the BVH's cache
+static const float* cached_projection(edge_bvh_t* bvh, mesh_t* mesh, mat4_t transform, int v) {
+    float* p = &bvh->projected[v * 3];
+    if (bvh->stamp[v] != bvh->frame) {
+        vec3_t pos = mesh->vertices[v].position;
+        float in[3] = { pos.x, pos.y, pos.z };
+        mat4_transform_point(transform, in, p);
+        bvh->stamp[v] = bvh->frame;
+    }
+    return p;
+}
+
+// Draw the edges in edge_index[begin..end)
+static void draw_slots(canvas_t* canvas, mesh_t* mesh, edge_bvh_t* bvh, mat4_t transform, int begin, int end) {
+    for (int i = begin; i < end; i++) {
+        const edge_t* e = &mesh->edges[bvh->edge_index[i]];
+        const float* p0 = cached_projection(bvh, mesh, transform, e->v0);
+        const float* p1 = cached_projection(bvh, mesh, transform, e->v1);
+
+        float x0, y0, x1, y1;
+        ndc_to_screen(canvas, p0[0], p0[1], &x0, &y0);
+        ndc_to_screen(canvas, p1[0], p1[1], &x1, &y1);
+
+        if (clip_to_circular_viewport(canvas, x0, y0) &&
+            clip_to_circular_viewport(canvas, x1, y1)) {
+            float brightness = compute_edge_brightness_xyz(p0, p1);
+            draw_line_f(canvas, x0, y0, x1, y1, 1.5f * brightness);
+        }
+    }
+}
+
+void render_wireframe_bvh(canvas_t* canvas, mesh_t* mesh, edge_bvh_t* bvh, mat4_t transform) {
+    int stack[BVH_STACK_SIZE];
+    int top = 0;
+
+    if (bvh->node_count == 0) return;
+
+    if (bvh->vertex_count != mesh->vertex_count) {
+        free(bvh->projected);
+        free(bvh->stamp);
+        bvh->vertex_count = mesh->vertex_count;
+        bvh->projected = malloc(sizeof(float) * 3 * mesh->vertex_count);
+        bvh->stamp = calloc(mesh->vertex_count, sizeof(unsigned));
+        bvh->frame = 0;
+    }
+    if (++bvh->frame == 0) {
+        memset(bvh->stamp, 0, sizeof(unsigned) * bvh->vertex_count);
+        bvh->frame = 1;
+    }
+
+    // Only nodes touching the circular viewport's bounding square can contribute
+    float cx = canvas->width / 2.0f;
+    float cy = canvas->height / 2.0f;
+    float radius = fminf(cx, cy) * 0.9f;
+
+    stack[top++] = 0;
+    while (top > 0) {
+        const bvh_node_t* n = &bvh->nodes[stack[--top]];
+        int side = classify_node_rect(n, canvas, transform, cx - radius, cy - radius, cx + radius, cy + radius);
+        if (side == BOX_OUTSIDE) continue;
+
+        // Whole subtrees on screen (the usual case) are drawn without further box tests
+        if (n->count == 0 && side != BOX_INSIDE) {
+            stack[top++] = n->first + 1;
+            stack[top++] = n->first;
+            continue;
+        }
+
+        int begin, end;
+        subtree_slots(bvh, n, &begin, &end);
+        draw_slots(canvas, mesh, bvh, transform, begin, end);
+    }
+}
+
+// ---------------- Picking ----------------
+
+static float dot3(const float* a, const float* b) {
+    return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+// Distance from the ray o + s*d (s >= 0) to the segment q0..q1
+static float ray_segment_distance(const float* o, const float* d, const float* q0, const float* q1) {
+    float d2[3] = { q1[0] - q0[0], q1[1] - q0[1], q1[2] - q0[2] };
+    float r[3] = { o[0] - q0[0], o[1] - q0[1], o[2] - q0[2] };
+    float a = dot3(d, d), e = dot3(d2, d2);
+    float b = dot3(d, d2), c = dot3(d, r), f = dot3(d2, r);
+    float s = 0.0f, t = 0.0f;
+
+    if (e <= 1e-12f) {
+        s = fmaxf(-c / a, 0.0f);
+    } else {
+        float denom = a * e - b * b;
+        if (denom > 1e-12f) s = fmaxf((b * f - c * e) / denom, 0.0f);
+        t = (b * s + f) / e;
+        if (t < 0.0f) {
+            t = 0.0f;
+            s = fmaxf(-c / a, 0.0f);
+        } else if (t > 1.0f) {
+            t = 1.0f;
+            s = fmaxf((b - c) / a, 0.0f);
+        }
+    }
+
+    float dx = o[0] + s * d[0] - (q0[0] + t * d2[0]);
+    float dy = o[1] + s * d[1] - (q0[1] + t * d2[1]);
+    float dz = o[2] + s * d[2] - (q0[2] + t * d2[2]);
+    return sqrtf(dx * dx + dy * dy + dz * dz);
+}
+
+// Distance from point p to the segment q0..q1
+static float point_segment_distance(const float* p, const float* q0, const float* q1) {
+    float d[3] = { q1[0] - q0[0], q1[1] - q0[1], q1[2] - q0[2] };
+    float r[3] = { p[0] - q0[0], p[1] - q0[1], p[2] - q0[2] };
+    float len_sq = dot3(d, d);
+    float t = len_sq > 1e-12f ? fminf(fmaxf(dot3(r, d) / len_sq, 0.0f), 1.0f) : 0.0f;
+    float dx = r[0] - t * d[0], dy = r[1] - t * d[1], dz = r[2] - t * d[2];
+    return sqrtf(dx * dx + dy * dy + dz * dz);
+}
+
+// Slab test of a ray against a box grown by `pad`
+static int ray_hits_box(const float* o, const float* d, const bvh_node_t* n, float pad) {
+    float tmin = 0.0f, tmax = FLT_MAX;
+    for (int a = 0; a < 3; a++) {
+        float lo = n->min[a] - pad, hi = n->max[a] + pad;
+        if (fabsf(d[a]) < 1e-12f) {
+            if (o[a] < lo || o[a] > hi) return 0;
+            continue;
+        }
+        float inv = 1.0f / d[a];
+        float t0 = (lo - o[a]) * inv, t1 = (hi - o[a]) * inv;
+        if (t0 > t1) { float tmp = t0; t0 = t1; t1 = tmp; }
+        tmin = fmaxf(tmin, t0);
+        tmax = fminf(tmax, t1);
+        if (tmin > tmax) return 0;
+    }
+    return 1;
+}
+
+static float box_distance_sq(const float* p, const bvh_node_t* n) {
+    float dist_sq = 0.0f;
+    for (int a = 0; a < 3; a++) {
+        float d = fmaxf(fmaxf(n->min[a] - p[a], 0.0f), p[a] - n->max[a]);
+        dist_sq += d * d;
+    }
+    return dist_sq;
+}
+
+static void edge_points(const mesh_t* mesh, int edge, float* q0, float* q1) {
+    vec3_t a = mesh->vertices[mesh->edges[edge].v0].position;
+    vec3_t b = mesh->vertices[mesh->edges[edge].v1].position;
+    q0[0] = a.x; q0[1] = a.y; q0[2] = a.z;
+    q1[0] = b.x; q1[1] = b.y; q1[2] = b.z;
+}
+
+int edge_bvh_pick_ray(const edge_bvh_t* bvh, const mesh_t* mesh, vec3_t origin, vec3_t dir,
+                      float max_dist, float* out_dist) {
+    float o[3] = { origin.x, origin.y, origin.z };
+    float d[3] = { dir.x, dir.y, dir.z };
+    int stack[BVH_STACK_SIZE];
+    int top = 0;
+    int best = -1;
+    float best_dist = max_dist;
+
+    if (bvh->node_count == 0 || dot3(d, d) <= 1e-12f) return -1;
+    stack[top++] = 0;
+
+    while (top > 0) {
+        const bvh_node_t* n = &bvh->nodes[stack[--top]];
+        if (!ray_hits_box(o, d, n, best_dist)) continue;
+
+        if (n->count == 0) {
+            stack[top++] = n->first + 1;
+            stack[top++] = n->first;
+            continue;
+        }
+        for (int i = 0; i < n->count; i++) {
+            int edge = bvh->edge_index[n->first + i];
+            float q0[3], q1[3];
+            edge_points(mesh, edge, q0, q1);
+            float dist = ray_segment_distance(o, d, q0, q1);
+            if (dist <= best_dist) {
+                best_dist = dist;
+                best = edge;
+            }
+        }
+    }
+
+    if (best >= 0 && out_dist) *out_dist = best_dist;
+    return best;
+}
+
+int edge_bvh_pick_point(const edge_bvh_t* bvh, const mesh_t* mesh, vec3_t point,
+                        float max_dist, float* out_dist) {
+    float p[3] = { point.x, point.y, point.z };
+    int stack[BVH_STACK_SIZE];
+    int top = 0;
+    int best = -1;
+    float best_dist = max_dist;
+
+    if (bvh->node_count == 0) return -1;
+    stack[top++] = 0;
+
+    while (top > 0) {
+        const bvh_node_t* n = &bvh->nodes[stack[--top]];
+        if (box_distance_sq(p, n) > best_dist * best_dist) continue;
+
+        if (n->count == 0) {
+            // Visit the nearer child first so the search radius shrinks sooner
+            int l = n->first, r = n->first + 1;
+            if (box_distance_sq(p, &bvh->nodes[l]) > box_distance_sq(p, &bvh->nodes[r])) {
+                int tmp = l; l = r; r = tmp;
+            }
+            stack[top++] = r;
+            stack[top++] = l;
+            continue;
+        }
+        for (int i = 0; i < n->count; i++) {
+            int edge = bvh->edge_index[n->first + i];
+            float q0[3], q1[3];
+            edge_points(mesh, edge, q0, q1);
+            float dist = point_segment_distance(p, q0, q1);
+            if (dist <= best_dist) {
+                best_dist = dist;
+                best = edge;
+            }
+        }
+    }
+
+    if (best >= 0 && out_dist) *out_dist = best_dist;
+    return best;
+}
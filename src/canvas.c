@@ -1,109 +1,451 @@
-#include <stdlib.h>
-#include <stdio.h>
-#include <math.h>
-#include "canvas.h"
-
-canvas_t* create_canvas(int width, int height) {
-    canvas_t* c = malloc(sizeof(canvas_t));
-    c->width = width;
-    c->height = height;
-    
-    c->pixels = malloc(height * sizeof(float*));
-    for (int i = 0; i < height; i++) {
-        c->pixels[i] = calloc(width, sizeof(float)); // start all pixels at 0.0
-    }
-    return c;
-}
-
-void free_canvas(canvas_t* c) {
-    for (int i = 0; i < c->height; i++) {
-        free(c->pixels[i]);
-    }
-    free(c->pixels);
-    free(c);
-}
-
-static float maxf(float a, float b) {
-    return a > b ? a : b;
-}
-
-void set_pixel_f(canvas_t* canvas, float x, float y, float intensity) {
-    int x0 = (int)floor(x);
-    int y0 = (int)floor(y);
-    int x1 = x0 + 1;
-    int y1 = y0 + 1;
-
-    float a = x - x0;
-    float b = y - y0;
-
-    float wA = (1 - a) * (1 - b);
-    float wB = a * (1 - b);
-    float wC = (1 - a) * b;
-    float wD = a * b;
-
-    if (x0 >= 0 && y0 >= 0 && x0 < canvas->width && y0 < canvas->height)
-        canvas->pixels[y0][x0] += intensity * wA;
-
-    if (x1 >= 0 && y0 >= 0 && x1 < canvas->width && y0 < canvas->height)
-        canvas->pixels[y0][x1] += intensity * wB;
-
-    if (x0 >= 0 && y1 >= 0 && x0 < canvas->width && y1 < canvas->height)
-        canvas->pixels[y1][x0] += intensity * wC;
-
-    if (x1 >= 0 && y1 >= 0 && x1 < canvas->width && y1 < canvas->height)
-        canvas->pixels[y1][x1] += intensity * wD;
-}
-
-void draw_line_f(canvas_t* canvas, float x0, float y0, float x1, float y1, float thickness) {
-    float dx = x1 - x0;
-    float dy = y1 - y0;
-    float length = sqrtf(dx * dx + dy * dy);
-
-    if (length == 0.0f) return;
-
-    float dir_x = dx / length;
-    float dir_y = dy / length;
-    float perp_x = -dir_y;
-    float perp_y = dir_x;
-
-    int steps = (int)(maxf(fabsf(dx), fabsf(dy)) * 2.0f);
-    float x_inc = dx / steps;
-    float y_inc = dy / steps;
-
-    for (int i = 0; i <= steps; i++) {
-        float cx = x0 + i * x_inc;
-        float cy = y0 + i * y_inc;
-
-        for (float t = -thickness / 2.0f; t <= thickness / 2.0f; t += 0.5f) {
-            float px = cx + t * perp_x;
-            float py = cy + t * perp_y;
-            set_pixel_f(canvas, px, py, 1.0f);
-        }
-    }
-}
-
-void save_canvas_as_ppm(canvas_t* canvas, const char* filename) {
-    FILE* file = fopen(filename, "wb");
-    if (!file) {
-        perror("Failed to open file");
-        return;
-    }
-
-    // Write PPM header
-    fprintf(file, "P6\n%d %d\n255\n", canvas->width, canvas->height);
-
-    // Write pixel data
-    for (int y = 0; y < canvas->height; y++) {
-        for (int x = 0; x < canvas->width; x++) {
-            unsigned char pixel[3];
-            // Convert grayscale to RGB (same value for R, G, B)
-            unsigned char value = (unsigned char)(fminf(canvas->pixels[y][x], 1.0f) * 255);
-            pixel[0] = value;
-            pixel[1] = value;
-            pixel[2] = value;
-            fwrite(pixel, 1, 3, file);
-        }
-    }
-
-    fclose(file);
-}
\ No newline at end of file
+#define _POSIX_C_SOURCE 200809L // posix_memalign
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+#include <stdint.h>
+#include "canvas.h"
+
+canvas_t* create_canvas(int width, int height) {
+    canvas_t* c = malloc(sizeof(canvas_t));
+    c->width = width;
+    c->height = height;
+    c->depth = NULL;
+    c->tiles = NULL;
+    c->tiles_x = c->tiles_y = 0;
+    c->pool = NULL;
+    c->owns_pool = 0;
+    c->external = 0;
+    
+    c->pixels = malloc(height * sizeof(float*));
+    for (int i = 0; i < height; i++) {
+        c->pixels[i] = calloc(width, sizeof(float)); // start all pixels at 0.0
+    }
+    return c;
+}
+
+#define TILE_FLOATS (CANVAS_TILE_SIZE * CANVAS_TILE_SIZE)
+
+tile_pool_t* create_tile_pool() {
+    return calloc(1, sizeof(tile_pool_t));
+}
+
+void free_tile_pool(tile_pool_t* pool) {
+    if (!pool) return;
+    for (int i = 0; i < pool->free_count; i++) {
+        free(pool->free_tiles[i]);
+    }
+    free(pool->free_tiles);
+    free(pool);
+}
+
+// Zeroed tile, reusing a released one when available
+static float* pool_acquire(tile_pool_t* pool) {
+    float* tile;
+    if (pool->free_count > 0) {
+        tile = pool->free_tiles[--pool->free_count];
+    } else {
+        // Drawing calls have no error path, so running out of tiles is fatal
+        int err = posix_memalign((void**)&tile, 64, sizeof(float) * TILE_FLOATS);
+        if (err != 0) {
+            fprintf(stderr, "Failed to allocate canvas tile: %s\n", strerror(err));
+            abort();
+        }
+        pool->allocated++;
+    }
+    memset(tile, 0, sizeof(float) * TILE_FLOATS);
+    pool->in_use++;
+    return tile;
+}
+
+static void pool_release(tile_pool_t* pool, float* tile) {
+    if (pool->free_count == pool->free_capacity) {
+        pool->free_capacity = pool->free_capacity ? pool->free_capacity * 2 : 64;
+        pool->free_tiles = realloc(pool->free_tiles, sizeof(float*) * pool->free_capacity);
+    }
+    pool->free_tiles[pool->free_count++] = tile;
+    pool->in_use--;
+}
+
+canvas_t* create_sparse_canvas(int width, int height, tile_pool_t* pool) {
+    canvas_t* c = malloc(sizeof(canvas_t));
+    c->width = width;
+    c->height = height;
+    c->pixels = NULL;
+    c->depth = NULL;
+    c->tiles_x = (width + CANVAS_TILE_SIZE - 1) / CANVAS_TILE_SIZE;
+    c->tiles_y = (height + CANVAS_TILE_SIZE - 1) / CANVAS_TILE_SIZE;
+    c->tiles = calloc((size_t)c->tiles_x * c->tiles_y + 1, sizeof(float*));
+    c->owns_pool = pool == NULL;
+    c->pool = pool ? pool : create_tile_pool();
+    c->external = 0;
+    return c;
+}
+
+canvas_t* create_canvas_external(void* memory, int width, int height, size_t stride, canvas_format_t format) {
+    if (format != CANVAS_FORMAT_F32 || !memory || width < 0 || height < 0) return NULL;
+    if (stride < sizeof(float) * width || stride % sizeof(float) != 0 ||
+        (uintptr_t)memory % _Alignof(float) != 0) {
+        fprintf(stderr, "create_canvas_external: unsupported stride or alignment\n");
+        return NULL;
+    }
+
+    canvas_t* c = malloc(sizeof(canvas_t));
+    c->width = width;
+    c->height = height;
+    c->depth = NULL;
+    c->tiles = NULL;
+    c->tiles_x = c->tiles_y = 0;
+    c->pool = NULL;
+    c->owns_pool = 0;
+    c->external = 1;
+
+    c->pixels = malloc((height > 0 ? height : 1) * sizeof(float*));
+    for (int i = 0; i < height; i++) {
+        c->pixels[i] = (float*)((unsigned char*)memory + (size_t)i * stride);
+    }
+    return c;
+}
+
+// Hand every tile back to the pool
+static void release_tiles(canvas_t* c) {
+    int count = c->tiles_x * c->tiles_y;
+    for (int i = 0; i < count; i++) {
+        if (c->tiles[i]) {
+            pool_release(c->pool, c->tiles[i]);
+            c->tiles[i] = NULL;
+        }
+    }
+}
+
+float* canvas_pixel_ptr(canvas_t* c, int x, int y) {
+    if (!c->tiles) return &c->pixels[y][x];
+    float** tile = &c->tiles[(y / CANVAS_TILE_SIZE) * c->tiles_x + x / CANVAS_TILE_SIZE];
+    if (!*tile) *tile = pool_acquire(c->pool);
+    return *tile + (y % CANVAS_TILE_SIZE) * CANVAS_TILE_SIZE + x % CANVAS_TILE_SIZE;
+}
+
+const float* canvas_row(canvas_t* c, int y, float* scratch) {
+    if (!c->tiles) return c->pixels[y];
+
+    const float* const* tiles = (const float* const*)&c->tiles[(y / CANVAS_TILE_SIZE) * c->tiles_x];
+    int offset = (y % CANVAS_TILE_SIZE) * CANVAS_TILE_SIZE;
+    for (int tx = 0; tx < c->tiles_x; tx++) {
+        int x0 = tx * CANVAS_TILE_SIZE;
+        int n = c->width - x0 < CANVAS_TILE_SIZE ? c->width - x0 : CANVAS_TILE_SIZE;
+        if (tiles[tx]) {
+            memcpy(scratch + x0, tiles[tx] + offset, sizeof(float) * n);
+        } else {
+            memset(scratch + x0, 0, sizeof(float) * n);
+        }
+    }
+    return scratch;
+}
+
+void free_canvas(canvas_t* c) {
+    if (c->pixels) {
+        if (!c->external) {
+            for (int i = 0; i < c->height; i++) {
+                free(c->pixels[i]);
+            }
+        }
+        free(c->pixels);
+    }
+    if (c->tiles) {
+        release_tiles(c);
+        free(c->tiles);
+        if (c->owns_pool) free_tile_pool(c->pool);
+    }
+    if (c->depth) {
+        for (int i = 0; i < c->height; i++) {
+            free(c->depth[i]);
+        }
+        free(c->depth);
+    }
+    free(c);
+}
+
+// Allocate the depth buffer on first use
+void canvas_enable_depth(canvas_t* canvas) {
+    if (canvas->depth) return;
+    canvas->depth = malloc(canvas->height * sizeof(float*));
+    for (int i = 0; i < canvas->height; i++) {
+        canvas->depth[i] = malloc(canvas->width * sizeof(float));
+    }
+    clear_depth(canvas);
+}
+
+// Reset every depth sample to "infinitely far"
+void clear_depth(canvas_t* canvas) {
+    if (!canvas->depth) return;
+    for (int y = 0; y < canvas->height; y++) {
+        for (int x = 0; x < canvas->width; x++) {
+            canvas->depth[y][x] = FLT_MAX;
+        }
+    }
+}
+
+void clear_canvas(canvas_t* canvas, float value) {
+    if (canvas->tiles) {
+        release_tiles(canvas);
+        if (value == 0.0f) return;
+        int count = canvas->tiles_x * canvas->tiles_y;
+        for (int i = 0; i < count; i++) {
+            canvas->tiles[i] = pool_acquire(canvas->pool);
+            for (int k = 0; k < TILE_FLOATS; k++) canvas->tiles[i][k] = value;
+        }
+        return;
+    }
+
+    for (int y = 0; y < canvas->height; y++) {
+        for (int x = 0; x < canvas->width; x++) {
+            canvas->pixels[y][x] = value;
+        }
+    }
+}
+
+static float maxf(float a, float b) {
+    return a > b ? a : b;
+}
+
+// Sparse-canvas tap: zero contributions never allocate a tile
+static void add_sample_sparse(canvas_t* canvas, int x, int y, float value) {
+    if (value != 0.0f && x >= 0 && y >= 0 && x < canvas->width && y < canvas->height)
+        *canvas_pixel_ptr(canvas, x, y) += value;
+}
+
+void set_pixel_f(canvas_t* canvas, float x, float y, float intensity) {
+    int x0 = (int)floor(x);
+    int y0 = (int)floor(y);
+    int x1 = x0 + 1;
+    int y1 = y0 + 1;
+
+    float a = x - x0;
+    float b = y - y0;
+
+    float wA = (1 - a) * (1 - b);
+    float wB = a * (1 - b);
+    float wC = (1 - a) * b;
+    float wD = a * b;
+
+    if (canvas->tiles) {
+        add_sample_sparse(canvas, x0, y0, intensity * wA);
+        add_sample_sparse(canvas, x1, y0, intensity * wB);
+        add_sample_sparse(canvas, x0, y1, intensity * wC);
+        add_sample_sparse(canvas, x1, y1, intensity * wD);
+        return;
+    }
+
+    if (x0 >= 0 && y0 >= 0 && x0 < canvas->width && y0 < canvas->height)
+        canvas->pixels[y0][x0] += intensity * wA;
+
+    if (x1 >= 0 && y0 >= 0 && x1 < canvas->width && y0 < canvas->height)
+        canvas->pixels[y0][x1] += intensity * wB;
+
+    if (x0 >= 0 && y1 >= 0 && x0 < canvas->width && y1 < canvas->height)
+        canvas->pixels[y1][x0] += intensity * wC;
+
+    if (x1 >= 0 && y1 >= 0 && x1 < canvas->width && y1 < canvas->height)
+        canvas->pixels[y1][x1] += intensity * wD;
+}
+
+void draw_line_f(canvas_t* canvas, float x0, float y0, float x1, float y1, float thickness) {
+    draw_line_fi(canvas, x0, y0, x1, y1, thickness, 1.0f);
+}
+
+// Step along one segment from sample first_step on, skipping samples whose
+// centre lies outside [y_min, y_max]. Returns 0 for a zero-length segment
+// (nothing drawn).
+static int draw_segment(canvas_t* canvas, float x0, float y0, float x1, float y1,
+                        float thickness, float intensity, int first_step, float y_min, float y_max) {
+    float dx = x1 - x0;
+    float dy = y1 - y0;
+    float length = sqrtf(dx * dx + dy * dy);
+
+    if (length == 0.0f) return 0;
+
+    float dir_x = dx / length;
+    float dir_y = dy / length;
+    float perp_x = -dir_y;
+    float perp_y = dir_x;
+
+    int steps = (int)(maxf(fabsf(dx), fabsf(dy)) * 2.0f);
+    float x_inc = dx / steps;
+    float y_inc = dy / steps;
+    int last_step = steps;
+
+    // Narrow the step range to the y window, one step wider on each side for rounding
+    if (steps > 0 && y_inc == 0.0f) {
+        if (!(y0 >= y_min && y0 <= y_max)) return 1;
+    } else if (steps > 0) {
+        float a = (y_min - y0) / y_inc;
+        float b = (y_max - y0) / y_inc;
+        float lo = floorf(fminf(a, b)) - 1.0f;
+        float hi = ceilf(fmaxf(a, b)) + 1.0f;
+        if (lo > first_step) first_step = lo < steps ? (int)lo : steps + 1;
+        if (hi < last_step) last_step = hi >= 0.0f ? (int)hi : -1;
+    }
+
+    for (int i = first_step; i <= last_step; i++) {
+        float cx = x0 + i * x_inc;
+        float cy = y0 + i * y_inc;
+
+        for (float t = -thickness / 2.0f; t <= thickness / 2.0f; t += 0.5f) {
+            float px = cx + t * perp_x;
+            float py = cy + t * perp_y;
+            set_pixel_f(canvas, px, py, intensity);
+        }
+    }
+    return 1;
+}
+
+// draw_line_f with a per-line intensity
+void draw_line_fi(canvas_t* canvas, float x0, float y0, float x1, float y1, float thickness, float intensity) {
+    draw_segment(canvas, x0, y0, x1, y1, thickness, intensity, 0, -INFINITY, INFINITY);
+}
+
+// A sample centred at cy touches rows floor(cy - thickness/2) .. floor(cy + thickness/2) + 1
+void draw_line_rows_f(canvas_t* canvas, float x0, float y0, float x1, float y1, float thickness,
+                      int row_begin, int row_end) {
+    float reach = thickness / 2.0f + 2.0f;
+    draw_segment(canvas, x0, y0, x1, y1, thickness, 1.0f, 0, row_begin - reach, row_end + reach);
+}
+
+// Connected segments through point_count xy pairs. A joint's sample is drawn by
+// the segment ending there and skipped by the one starting there.
+void draw_polyline_f(canvas_t* canvas, const float* xy, int point_count, const float* thickness) {
+    int joint_drawn = 0; // Zero-length segments leave the joint where it was
+    for (int k = 0; k + 1 < point_count; k++) {
+        if (draw_segment(canvas, xy[k * 2], xy[k * 2 + 1], xy[k * 2 + 2], xy[k * 2 + 3],
+                         thickness[k], 1.0f, joint_drawn, -INFINITY, INFINITY))
+            joint_drawn = 1;
+    }
+}
+
+// Depth-tested splat: each bilinear tap is only added where z is not behind the
+// stored depth (plus bias). The depth buffer itself is not written.
+void set_pixel_depth_f(canvas_t* canvas, float x, float y, float z, float intensity, float bias) {
+    int x0 = (int)floor(x);
+    int y0 = (int)floor(y);
+    int x1 = x0 + 1;
+    int y1 = y0 + 1;
+
+    float a = x - x0;
+    float b = y - y0;
+
+    float wA = (1 - a) * (1 - b);
+    float wB = a * (1 - b);
+    float wC = (1 - a) * b;
+    float wD = a * b;
+
+    float limit = z - bias;
+
+    if (x0 >= 0 && y0 >= 0 && x0 < canvas->width && y0 < canvas->height && limit <= canvas->depth[y0][x0])
+        *canvas_pixel_ptr(canvas, x0, y0) += intensity * wA;
+
+    if (x1 >= 0 && y0 >= 0 && x1 < canvas->width && y0 < canvas->height && limit <= canvas->depth[y0][x1])
+        *canvas_pixel_ptr(canvas, x1, y0) += intensity * wB;
+
+    if (x0 >= 0 && y1 >= 0 && x0 < canvas->width && y1 < canvas->height && limit <= canvas->depth[y1][x0])
+        *canvas_pixel_ptr(canvas, x0, y1) += intensity * wC;
+
+    if (x1 >= 0 && y1 >= 0 && x1 < canvas->width && y1 < canvas->height && limit <= canvas->depth[y1][x1])
+        *canvas_pixel_ptr(canvas, x1, y1) += intensity * wD;
+}
+
+// Same stepping as draw_line_f, with z interpolated along the line
+void draw_line_depth_f(canvas_t* canvas, float x0, float y0, float z0,
+                       float x1, float y1, float z1, float thickness, float bias) {
+    if (!canvas->depth) {
+        draw_line_f(canvas, x0, y0, x1, y1, thickness);
+        return;
+    }
+
+    float dx = x1 - x0;
+    float dy = y1 - y0;
+    float length = sqrtf(dx * dx + dy * dy);
+
+    if (length == 0.0f) return;
+
+    float dir_x = dx / length;
+    float dir_y = dy / length;
+    float perp_x = -dir_y;
+    float perp_y = dir_x;
+
+    int steps = (int)(maxf(fabsf(dx), fabsf(dy)) * 2.0f);
+    if (steps < 1) steps = 1;
+    float x_inc = dx / steps;
+    float y_inc = dy / steps;
+    float z_inc = (z1 - z0) / steps;
+
+    for (int i = 0; i <= steps; i++) {
+        float cx = x0 + i * x_inc;
+        float cy = y0 + i * y_inc;
+        float cz = z0 + i * z_inc;
+
+        for (float t = -thickness / 2.0f; t <= thickness / 2.0f; t += 0.5f) {
+            float px = cx + t * perp_x;
+            float py = cy + t * perp_y;
+            set_pixel_depth_f(canvas, px, py, cz, 1.0f, bias);
+        }
+    }
+}
+
+void save_canvas_as_ppm(canvas_t* canvas, const char* filename) {
+    FILE* file = fopen(filename, "wb");
+    if (!file) {
+        perror("Failed to open file");
+        return;
+    }
+
+    // Write PPM header
+    fprintf(file, "P6\n%d %d\n255\n", canvas->width, canvas->height);
+
+    // Write pixel data
+    float* scratch = canvas->tiles ? malloc(sizeof(float) * canvas->width) : NULL;
+    for (int y = 0; y < canvas->height; y++) {
+        const float* row = canvas_row(canvas, y, scratch);
+        for (int x = 0; x < canvas->width; x++) {
+            unsigned char pixel[3];
+            // Convert grayscale to RGB (same value for R, G, B)
+            unsigned char value = (unsigned char)(fminf(row[x], 1.0f) * 255);
+            pixel[0] = value;
+            pixel[1] = value;
+            pixel[2] = value;
+            fwrite(pixel, 1, 3, file);
+        }
+    }
+
+    free(scratch);
+    fclose(file);
+}
+
+// Bytes needed by encode_canvas_as_ppm (header plus RGB data)
+size_t canvas_ppm_size(canvas_t* canvas) {
+    char header[64];
+    int header_len = snprintf(header, sizeof(header), "P6\n%d %d\n255\n", canvas->width, canvas->height);
+    return (size_t)header_len + (size_t)canvas->width * canvas->height * 3;
+}
+
+// Serialize to an in-memory PPM; out must hold canvas_ppm_size() bytes
+size_t encode_canvas_as_ppm(canvas_t* canvas, unsigned char* out) {
+    char header[64];
+    int header_len = snprintf(header, sizeof(header), "P6\n%d %d\n255\n", canvas->width, canvas->height);
+    memcpy(out, header, header_len);
+    unsigned char* p = out + header_len;
+
+    float* scratch = canvas->tiles ? malloc(sizeof(float) * canvas->width) : NULL;
+    for (int y = 0; y < canvas->height; y++) {
+        const float* row = canvas_row(canvas, y, scratch);
+        for (int x = 0; x < canvas->width; x++) {
+            unsigned char value = (unsigned char)(fminf(row[x], 1.0f) * 255);
+            p[0] = value;
+            p[1] = value;
+            p[2] = value;
+            p += 3;
+        }
+    }
+    free(scratch);
+    return (size_t)(p - out);
+}
@@ -0,0 +1,214 @@
+#include "displaylist.h"
+#include <limits.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define DISPLAY_LIST_MAGIC "T3DL"
+#define DISPLAY_LIST_VERSION 1
+#define DISPLAY_LIST_HEADER_SIZE 12
+
+display_list_t* create_display_list() {
+    display_list_t* list = malloc(sizeof(display_list_t));
+    list->segments = NULL;
+    list->count = 0;
+    list->capacity = 0;
+    return list;
+}
+
+void free_display_list(display_list_t* list) {
+    if (list) {
+        free(list->segments);
+        free(list);
+    }
+}
+
+void clear_display_list(display_list_t* list) {
+    list->count = 0;
+}
+
+// Grow to at least needed segments. Returns 0 (list unchanged) if that cannot be allocated.
+static int reserve(display_list_t* list, size_t needed) {
+    if (needed <= (size_t)list->capacity) return 1;
+    if (needed > INT_MAX) return 0;
+
+    size_t capacity = list->capacity ? (size_t)list->capacity : 256;
+    while (capacity < needed) capacity *= 2;
+    if (capacity > INT_MAX) capacity = needed;
+    if (capacity > SIZE_MAX / sizeof(display_segment_t)) return 0;
+
+    display_segment_t* segments = realloc(list->segments, sizeof(display_segment_t) * capacity);
+    if (!segments) return 0;
+    list->segments = segments;
+    list->capacity = (int)capacity;
+    return 1;
+}
+
+void display_list_record(display_list_t* list, mesh_t* mesh, mat4_t transform) {
+    float* xyz = malloc(sizeof(float) * 3 * (mesh->vertex_count > 0 ? mesh->vertex_count : 1));
+    for (int i = 0; i < mesh->vertex_count; i++) {
+        vec3_t p = mesh->vertices[i].position;
+        float in[3] = { p.x, p.y, p.z };
+        mat4_transform_point(transform, in, &xyz[i * 3]);
+    }
+
+    if (!reserve(list, (size_t)list->count + mesh->edge_count)) {
+        fprintf(stderr, "display_list_record: out of memory for %d segments\n", mesh->edge_count);
+        free(xyz);
+        return;
+    }
+    for (int i = 0; i < mesh->edge_count; i++) {
+        const float* p0 = &xyz[mesh->edges[i].v0 * 3];
+        const float* p1 = &xyz[mesh->edges[i].v1 * 3];
+        display_segment_t* seg = &list->segments[list->count++];
+        seg->x0 = p0[0];
+        seg->y0 = p0[1];
+        seg->x1 = p1[0];
+        seg->y1 = p1[1];
+        seg->brightness = compute_edge_brightness_xyz(p0, p1);
+    }
+
+    free(xyz);
+}
+
+// Interleave the low 16 bits of x and y
+static unsigned interleave16(unsigned x, unsigned y) {
+    x &= 0xffff; y &= 0xffff;
+    x = (x | (x << 8)) & 0x00ff00ff; y = (y | (y << 8)) & 0x00ff00ff;
+    x = (x | (x << 4)) & 0x0f0f0f0f; y = (y | (y << 4)) & 0x0f0f0f0f;
+    x = (x | (x << 2)) & 0x33333333; y = (y | (y << 2)) & 0x33333333;
+    x = (x | (x << 1)) & 0x55555555; y = (y | (y << 1)) & 0x55555555;
+    return x | (y << 1);
+}
+
+static unsigned quantize(float v) {
+    float t = (v + 1.0f) * 0.5f; // [-1, 1] -> [0, 1]
+    if (!(t > 0.0f)) t = 0.0f;
+    if (t > 1.0f) t = 1.0f;
+    return (unsigned)(t * 65535.0f);
+}
+
+void display_list_sort(display_list_t* list) {
+    int n = list->count;
+    if (n < 2) return;
+
+    unsigned* keys = malloc(sizeof(unsigned) * n);
+    int* order = malloc(sizeof(int) * n);
+    int* tmp = malloc(sizeof(int) * n);
+    for (int i = 0; i < n; i++) {
+        const display_segment_t* s = &list->segments[i];
+        keys[i] = interleave16(quantize(0.5f * (s->x0 + s->x1)), quantize(0.5f * (s->y0 + s->y1)));
+        order[i] = i;
+    }
+
+    // Stable LSD radix sort, 8 bits per pass
+    int counts[256];
+    for (int shift = 0; shift < 32; shift += 8) {
+        memset(counts, 0, sizeof(counts));
+        for (int i = 0; i < n; i++) counts[(keys[order[i]] >> shift) & 0xff]++;
+        for (int b = 0, sum = 0; b < 256; b++) {
+            int c = counts[b];
+            counts[b] = sum;
+            sum += c;
+        }
+        for (int i = 0; i < n; i++) tmp[counts[(keys[order[i]] >> shift) & 0xff]++] = order[i];
+        int* swap = order; order = tmp; tmp = swap;
+    }
+
+    display_segment_t* sorted = malloc(sizeof(display_segment_t) * list->capacity);
+    for (int i = 0; i < n; i++) sorted[i] = list->segments[order[i]];
+    free(list->segments);
+    list->segments = sorted;
+
+    free(keys);
+    free(order);
+    free(tmp);
+}
+
+void display_list_replay(canvas_t* canvas, const display_list_t* list,
+                         const render_config_t* config, float intensity) {
+    for (int i = 0; i < list->count; i++) {
+        const display_segment_t* seg = &list->segments[i];
+        float x0, y0, x1, y1;
+        ndc_to_screen(canvas, seg->x0, seg->y0, &x0, &y0);
+        ndc_to_screen(canvas, seg->x1, seg->y1, &x1, &y1);
+
+        if (config->viewport == VIEWPORT_CIRCLE) {
+            if (!clip_to_circular_viewport(canvas, x0, y0) || !clip_to_circular_viewport(canvas, x1, y1))
+                continue;
+        } else if (config->viewport == VIEWPORT_RECT) {
+            if (!(x0 >= config->rect_x0 && x0 <= config->rect_x1 && y0 >= config->rect_y0 && y0 <= config->rect_y1 &&
+                  x1 >= config->rect_x0 && x1 <= config->rect_x1 && y1 >= config->rect_y0 && y1 <= config->rect_y1))
+                continue;
+        }
+
+        float brightness = config->lighting ? seg->brightness : 1.0f;
+        float thickness = config->variable_thickness ? config->thickness * brightness : config->thickness;
+        draw_line_fi(canvas, x0, y0, x1, y1, thickness, intensity);
+    }
+}
+
+int save_display_list(const display_list_t* list, const char* filename) {
+    FILE* file = fopen(filename, "wb");
+    if (!file) {
+        perror("Failed to open file");
+        return 0;
+    }
+
+    int version = DISPLAY_LIST_VERSION;
+    fwrite(DISPLAY_LIST_MAGIC, 1, 4, file);
+    fwrite(&version, sizeof(int), 1, file);
+    fwrite(&list->count, sizeof(int), 1, file);
+    fwrite(list->segments, sizeof(display_segment_t), list->count, file);
+
+    int ok = !ferror(file);
+    fclose(file);
+    return ok;
+}
+
+display_list_t* load_display_list(const char* filename) {
+    FILE* file = fopen(filename, "rb");
+    if (!file) {
+        perror("Failed to open file");
+        return NULL;
+    }
+
+    char magic[4];
+    int version = 0, count = 0;
+    if (fread(magic, 1, 4, file) != 4 || memcmp(magic, DISPLAY_LIST_MAGIC, 4) != 0 ||
+        fread(&version, sizeof(int), 1, file) != 1 || version != DISPLAY_LIST_VERSION ||
+        fread(&count, sizeof(int), 1, file) != 1 || count < 0) {
+        fprintf(stderr, "Not a display list file: %s\n", filename);
+        fclose(file);
+        return NULL;
+    }
+
+    // The count must fit in the rest of the file before anything is allocated for it
+    long size = -1;
+    if (fseek(file, 0, SEEK_END) == 0) size = ftell(file);
+    if (size < DISPLAY_LIST_HEADER_SIZE || fseek(file, DISPLAY_LIST_HEADER_SIZE, SEEK_SET) != 0 ||
+        (size_t)count > (size_t)(size - DISPLAY_LIST_HEADER_SIZE) / sizeof(display_segment_t)) {
+        fprintf(stderr, "Truncated display list file: %s\n", filename);
+        fclose(file);
+        return NULL;
+    }
+
+    display_list_t* list = create_display_list();
+    if (!reserve(list, count)) {
+        fprintf(stderr, "Out of memory loading display list: %s\n", filename);
+        free_display_list(list);
+        fclose(file);
+        return NULL;
+    }
+    if (fread(list->segments, sizeof(display_segment_t), count, file) != (size_t)count) {
+        fprintf(stderr, "Truncated display list file: %s\n", filename);
+        free_display_list(list);
+        fclose(file);
+        return NULL;
+    }
+    list->count = count;
+    fclose(file);
+    return list;
+}
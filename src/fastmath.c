@@ -0,0 +1,156 @@
+#include "fastmath.h"
+#include <math.h>
+
+#define FOUR_OVER_PI 1.27323954473516f
+#define PI_F 3.14159265358979f
+#define HALF_PI_F 1.57079632679490f
+#define QUARTER_PI_F 0.78539816339745f
+
+// pi/4 split into three parts for Cody-Waite argument reduction
+#define DP1 0.78515625f
+#define DP2 2.4187564849853515625e-4f
+#define DP3 3.77489497744594108e-8f
+
+static float sin_poly(float r, float z) {
+    return ((-1.9515295891e-4f * z + 8.3321608736e-3f) * z - 1.6666654611e-1f) * z * r + r;
+}
+
+static float cos_poly(float z) {
+    return ((2.443315711809948e-5f * z - 1.388731625493765e-3f) * z + 4.166664568298827e-2f) * z * z
+           - 0.5f * z + 1.0f;
+}
+
+// atan on [0, 1] (reduced once more around tan(pi/8))
+static float atan_unit(float t) {
+    float base = 0.0f;
+    if (t > 0.4142135623730950f) {
+        base = QUARTER_PI_F;
+        t = (t - 1.0f) / (t + 1.0f);
+    }
+    float z = t * t;
+    return base + (((8.05374449538e-2f * z - 1.38776856032e-1f) * z + 1.99777106478e-1f) * z
+                   - 3.33329491539e-1f) * z * t + t;
+}
+
+// Reduce |x| to r in [-pi/4, pi/4] and return the quadrant
+static int reduce(float ax, float* r) {
+    int j = (int)(ax * FOUR_OVER_PI);
+    j += j & 1;
+    float y = (float)j;
+    *r = ((ax - y * DP1) - y * DP2) - y * DP3;
+    return (j >> 1) & 3;
+}
+
+void fast_sincosf(float x, float* s, float* c) {
+    float ax = fabsf(x);
+    if (!(ax <= FAST_TRIG_MAX_ARG)) {
+        *s = sinf(x);
+        *c = cosf(x);
+        return;
+    }
+
+    float r;
+    int q = reduce(ax, &r);
+    float z = r * r;
+    float sp = sin_poly(r, z);
+    float cp = cos_poly(z);
+
+    float sv = (q & 1) ? cp : sp;
+    float cv = (q & 1) ? sp : cp;
+    if (q & 2) sv = -sv;
+    if ((q + 1) & 2) cv = -cv;
+    *s = x < 0.0f ? -sv : sv;
+    *c = cv;
+}
+
+float fast_sinf(float x) {
+    float s, c;
+    fast_sincosf(x, &s, &c);
+    return s;
+}
+
+float fast_cosf(float x) {
+    float s, c;
+    fast_sincosf(x, &s, &c);
+    return c;
+}
+
+float fast_acosf(float x) {
+    float a = fabsf(x);
+    if (a > 1.0f) return NAN;
+
+    // asin polynomial on [0, 0.5]; larger inputs use acos(a) = 2 asin(sqrt((1 - a) / 2))
+    float z, s;
+    int far = a > 0.5f;
+    if (far) {
+        z = 0.5f * (1.0f - a);
+        s = sqrtf(z);
+    } else {
+        z = a * a;
+        s = a;
+    }
+    float p = ((((4.2163199048e-2f * z + 2.4181311049e-2f) * z + 4.5470025998e-2f) * z
+                + 7.4953002686e-2f) * z + 1.6666752422e-1f) * z * s + s;
+
+    if (far) {
+        float r = 2.0f * p;
+        return x < 0.0f ? PI_F - r : r;
+    }
+    return HALF_PI_F - (x < 0.0f ? -p : p);
+}
+
+float fast_atan2f(float y, float x) {
+    float ax = fabsf(x), ay = fabsf(y);
+    float hi = fmaxf(ax, ay), lo = fminf(ax, ay);
+    if (hi == 0.0f) return (signbit(x) ? PI_F : 0.0f) * (signbit(y) ? -1.0f : 1.0f);
+
+    float a = atan_unit(lo / hi);
+    if (ay > ax) a = HALF_PI_F - a;
+    if (x < 0.0f) a = PI_F - a;
+    return signbit(y) ? -a : a;
+}
+
+void fast_sincosf_array(const float* x, float* s, float* c, int count) {
+    for (int i = 0; i < count; i++) {
+        float ax = fabsf(x[i]);
+        int j = (int)(ax * FOUR_OVER_PI);
+        j += j & 1;
+        float y = (float)j;
+        float r = ((ax - y * DP1) - y * DP2) - y * DP3;
+        int q = j >> 1;
+
+        float z = r * r;
+        float sp = sin_poly(r, z);
+        float cp = cos_poly(z);
+
+        // Select and sign with arithmetic instead of branches
+        float swap = (float)(q & 1);
+        float sv = sp + swap * (cp - sp);
+        float cv = cp + swap * (sp - cp);
+        sv *= 1.0f - (float)(q & 2);
+        cv *= 1.0f - (float)((q + 1) & 2);
+        s[i] = x[i] < 0.0f ? -sv : sv;
+        c[i] = cv;
+    }
+}
+
+void fast_atan2f_array(const float* y, const float* x, float* out, int count) {
+    for (int i = 0; i < count; i++) {
+        float ax = fabsf(x[i]), ay = fabsf(y[i]);
+        float hi = fmaxf(ax, ay), lo = fminf(ax, ay);
+        float t = hi > 0.0f ? lo / hi : 0.0f;
+
+        // Second reduction around tan(pi/8), selected arithmetically
+        float big = (float)(t > 0.4142135623730950f);
+        float tr = t + big * ((t - 1.0f) / (t + 1.0f) - t);
+        float z = tr * tr;
+        float a = big * QUARTER_PI_F
+                  + (((8.05374449538e-2f * z - 1.38776856032e-1f) * z + 1.99777106478e-1f) * z
+                     - 3.33329491539e-1f) * z * tr + tr;
+
+        a = ay > ax ? HALF_PI_F - a : a;
+        // signbit, like fast_atan2f, so signed zeros pick the right half-plane
+        a = signbit(x[i]) ? PI_F - a : a;
+        out[i] = signbit(y[i]) ? -a : a;
+    }
+}
@@ -0,0 +1,377 @@
+#include "framecache.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include <dirent.h>
+#include <sys/stat.h>
+
+#define FNV_OFFSET 0xcbf29ce484222325ULL
+#define FNV_PRIME 0x100000001b3ULL
+#define INITIAL_BUCKETS 256
+#define FRAME_FILE_SUFFIX ".frame"
+
+// ---------------- Hashing ----------------
+
+static uint64_t hash_bytes(uint64_t h, const void* data, size_t size) {
+    const unsigned char* p = data;
+    for (size_t i = 0; i < size; i++) {
+        h ^= p[i];
+        h *= FNV_PRIME;
+    }
+    return h;
+}
+
+static uint64_t hash_int(uint64_t h, int v) {
+    return hash_bytes(h, &v, sizeof(v));
+}
+
+static uint64_t hash_float(uint64_t h, float v) {
+    return hash_bytes(h, &v, sizeof(v));
+}
+
+uint64_t mesh_content_hash(const mesh_t* mesh) {
+    uint64_t h = FNV_OFFSET;
+    h = hash_int(h, mesh->vertex_count);
+    h = hash_int(h, mesh->edge_count);
+    for (int i = 0; i < mesh->vertex_count; i++) {
+        h = hash_float(h, mesh->vertices[i].position.x);
+        h = hash_float(h, mesh->vertices[i].position.y);
+        h = hash_float(h, mesh->vertices[i].position.z);
+    }
+    for (int i = 0; i < mesh->edge_count; i++) {
+        h = hash_int(h, mesh->edges[i].v0);
+        h = hash_int(h, mesh->edges[i].v1);
+    }
+    return h;
+}
+
+uint64_t frame_cache_key(uint64_t mesh_id, unsigned mesh_version, mat4_t transform,
+                         const light_t* lights, int light_count, int width, int height,
+                         const render_config_t* config) {
+    uint64_t h = FNV_OFFSET;
+    h = hash_bytes(h, &mesh_id, sizeof(mesh_id));
+    h = hash_bytes(h, &mesh_version, sizeof(mesh_version));
+    h = hash_bytes(h, transform.m, sizeof(transform.m));
+
+    h = hash_int(h, light_count);
+    for (int i = 0; i < light_count; i++) {
+        h = hash_float(h, lights[i].direction.x);
+        h = hash_float(h, lights[i].direction.y);
+        h = hash_float(h, lights[i].direction.z);
+        h = hash_float(h, lights[i].intensity);
+    }
+
+    h = hash_int(h, width);
+    h = hash_int(h, height);
+
+    // Field by field so struct padding never reaches the hash
+    if (config) {
+        h = hash_int(h, config->lighting);
+        h = hash_int(h, (int)config->viewport);
+        h = hash_float(h, config->rect_x0);
+        h = hash_float(h, config->rect_y0);
+        h = hash_float(h, config->rect_x1);
+        h = hash_float(h, config->rect_y1);
+        h = hash_int(h, config->variable_thickness);
+        h = hash_float(h, config->thickness);
+    }
+    return h;
+}
+
+// ---------------- LRU lists ----------------
+
+static void mem_unlink(frame_cache_t* c, frame_entry_t* e) {
+    if (e->mem_prev) e->mem_prev->mem_next = e->mem_next; else c->mem_head = e->mem_next;
+    if (e->mem_next) e->mem_next->mem_prev = e->mem_prev; else c->mem_tail = e->mem_prev;
+    e->mem_prev = e->mem_next = NULL;
+}
+
+static void mem_push_front(frame_cache_t* c, frame_entry_t* e) {
+    e->mem_prev = NULL;
+    e->mem_next = c->mem_head;
+    if (c->mem_head) c->mem_head->mem_prev = e; else c->mem_tail = e;
+    c->mem_head = e;
+}
+
+static void disk_unlink(frame_cache_t* c, frame_entry_t* e) {
+    if (e->disk_prev) e->disk_prev->disk_next = e->disk_next; else c->disk_head = e->disk_next;
+    if (e->disk_next) e->disk_next->disk_prev = e->disk_prev; else c->disk_tail = e->disk_prev;
+    e->disk_prev = e->disk_next = NULL;
+}
+
+static void disk_push_front(frame_cache_t* c, frame_entry_t* e) {
+    e->disk_prev = NULL;
+    e->disk_next = c->disk_head;
+    if (c->disk_head) c->disk_head->disk_prev = e; else c->disk_tail = e;
+    c->disk_head = e;
+}
+
+// ---------------- Hash table ----------------
+
+static frame_entry_t* find_entry(frame_cache_t* c, uint64_t key) {
+    for (frame_entry_t* e = c->buckets[key & (c->bucket_count - 1)]; e; e = e->hash_next) {
+        if (e->key == key) return e;
+    }
+    return NULL;
+}
+
+static void grow_buckets(frame_cache_t* c) {
+    int count = c->bucket_count * 2;
+    frame_entry_t** buckets = calloc(count, sizeof(frame_entry_t*));
+    for (int b = 0; b < c->bucket_count; b++) {
+        frame_entry_t* e = c->buckets[b];
+        while (e) {
+            frame_entry_t* next = e->hash_next;
+            e->hash_next = buckets[e->key & (count - 1)];
+            buckets[e->key & (count - 1)] = e;
+            e = next;
+        }
+    }
+    free(c->buckets);
+    c->buckets = buckets;
+    c->bucket_count = count;
+}
+
+static frame_entry_t* insert_entry(frame_cache_t* c, uint64_t key) {
+    if (c->entry_count >= c->bucket_count * 2) grow_buckets(c);
+    frame_entry_t* e = calloc(1, sizeof(frame_entry_t));
+    e->key = key;
+    e->hash_next = c->buckets[key & (c->bucket_count - 1)];
+    c->buckets[key & (c->bucket_count - 1)] = e;
+    c->entry_count++;
+    return e;
+}
+
+static void remove_entry(frame_cache_t* c, frame_entry_t* e) {
+    frame_entry_t** link = &c->buckets[e->key & (c->bucket_count - 1)];
+    while (*link != e) link = &(*link)->hash_next;
+    *link = e->hash_next;
+    c->entry_count--;
+    free(e->data);
+    free(e);
+}
+
+// ---------------- Disk tier ----------------
+
+static void entry_path(const frame_cache_t* c, uint64_t key, char* path, size_t size) {
+    snprintf(path, size, "%s/%016" PRIx64 FRAME_FILE_SUFFIX, c->disk_dir, key);
+}
+
+static void drop_from_disk(frame_cache_t* c, frame_entry_t* e) {
+    char path[1024];
+    entry_path(c, e->key, path, sizeof(path));
+    remove(path);
+    disk_unlink(c, e);
+    c->disk_used -= e->size;
+    e->on_disk = 0;
+    if (!e->data) remove_entry(c, e);
+}
+
+static void trim_disk(frame_cache_t* c, size_t incoming) {
+    while (c->disk_tail && c->disk_used + incoming > c->disk_budget) {
+        drop_from_disk(c, c->disk_tail);
+        c->evictions++;
+    }
+}
+
+static int spill_to_disk(frame_cache_t* c, frame_entry_t* e) {
+    if (e->on_disk) return 1;
+    if (!c->disk_dir || e->size > c->disk_budget) return 0;
+    trim_disk(c, e->size);
+
+    char path[1024];
+    entry_path(c, e->key, path, sizeof(path));
+    FILE* file = fopen(path, "wb");
+    if (!file) return 0;
+    int ok = fwrite(e->data, 1, e->size, file) == e->size;
+    fclose(file);
+    if (!ok) {
+        remove(path);
+        return 0;
+    }
+
+    e->on_disk = 1;
+    disk_push_front(c, e);
+    c->disk_used += e->size;
+    return 1;
+}
+
+// Index frame files left by a previous run
+static void scan_disk(frame_cache_t* c) {
+    DIR* dir = opendir(c->disk_dir);
+    if (!dir) return;
+
+    struct dirent* ent;
+    size_t suffix_len = strlen(FRAME_FILE_SUFFIX);
+    while ((ent = readdir(dir)) != NULL) {
+        size_t len = strlen(ent->d_name);
+        if (len != 16 + suffix_len || strcmp(ent->d_name + 16, FRAME_FILE_SUFFIX) != 0) continue;
+
+        char* end;
+        uint64_t key = strtoull(ent->d_name, &end, 16);
+        if (end != ent->d_name + 16 || find_entry(c, key)) continue;
+
+        char path[1024];
+        struct stat st;
+        entry_path(c, key, path, sizeof(path));
+        if (stat(path, &st) != 0) continue;
+
+        frame_entry_t* e = insert_entry(c, key);
+        e->size = (size_t)st.st_size;
+        e->on_disk = 1;
+        disk_push_front(c, e);
+        c->disk_used += e->size;
+    }
+    closedir(dir);
+    trim_disk(c, 0);
+}
+
+// ---------------- Memory tier ----------------
+
+// Drop an entry's memory copy, spilling it to disk when possible
+static void evict_from_memory(frame_cache_t* c, frame_entry_t* e) {
+    spill_to_disk(c, e);
+    mem_unlink(c, e);
+    c->memory_used -= e->size;
+    free(e->data);
+    e->data = NULL;
+    c->evictions++;
+    if (!e->on_disk) remove_entry(c, e);
+}
+
+static void trim_memory(frame_cache_t* c, size_t incoming, frame_entry_t* keep) {
+    while (c->mem_tail && c->memory_used + incoming > c->memory_budget) {
+        frame_entry_t* victim = c->mem_tail;
+        if (victim == keep) break;
+        evict_from_memory(c, victim);
+    }
+}
+
+// ---------------- Public API ----------------
+
+frame_cache_t* create_frame_cache(size_t memory_budget, const char* disk_dir, size_t disk_budget) {
+    frame_cache_t* c = calloc(1, sizeof(frame_cache_t));
+    c->bucket_count = INITIAL_BUCKETS;
+    c->buckets = calloc(c->bucket_count, sizeof(frame_entry_t*));
+    c->memory_budget = memory_budget;
+    c->disk_budget = disk_budget;
+    if (disk_dir) {
+        c->disk_dir = malloc(strlen(disk_dir) + 1);
+        strcpy(c->disk_dir, disk_dir);
+        mkdir(disk_dir, 0755);
+        scan_disk(c);
+    }
+    return c;
+}
+
+void free_frame_cache(frame_cache_t* c) {
+    if (!c) return;
+    for (int b = 0; b < c->bucket_count; b++) {
+        frame_entry_t* e = c->buckets[b];
+        while (e) {
+            frame_entry_t* next = e->hash_next;
+            free(e->data);
+            free(e);
+            e = next;
+        }
+    }
+    free(c->buckets);
+    free(c->disk_dir);
+    free(c);
+}
+
+const unsigned char* frame_cache_lookup(frame_cache_t* c, uint64_t key, size_t* size) {
+    frame_entry_t* e = find_entry(c, key);
+    if (!e) {
+        c->misses++;
+        return NULL;
+    }
+
+    if (!e->data) {
+        // Disk hit: promote back into memory
+        char path[1024];
+        entry_path(c, key, path, sizeof(path));
+        FILE* file = fopen(path, "rb");
+        unsigned char* data = file ? malloc(e->size) : NULL;
+        int ok = data && fread(data, 1, e->size, file) == e->size;
+        if (file) fclose(file);
+        if (!ok) {
+            free(data);
+            disk_unlink(c, e);
+            c->disk_used -= e->size;
+            e->on_disk = 0;
+            remove_entry(c, e);
+            c->misses++;
+            return NULL;
+        }
+
+        disk_unlink(c, e);
+        disk_push_front(c, e);
+
+        // Resident before trimming so spills can't drop it; an oversized frame
+        // stays only until the next call trims it back out
+        e->data = data;
+        c->memory_used += e->size;
+        mem_push_front(c, e);
+        trim_memory(c, 0, e);
+    } else {
+        mem_unlink(c, e);
+        mem_push_front(c, e);
+    }
+
+    c->hits++;
+    if (size) *size = e->size;
+    return e->data;
+}
+
+int frame_cache_store(frame_cache_t* c, uint64_t key, const unsigned char* data, size_t size) {
+    frame_entry_t* e = find_entry(c, key);
+    if (e) {
+        if (e->on_disk) drop_from_disk(c, e);
+        e = find_entry(c, key);
+        if (e) {
+            mem_unlink(c, e);
+            c->memory_used -= e->size;
+            remove_entry(c, e);
+        }
+    }
+
+    if (size > c->memory_budget && !c->disk_dir) return 0;
+
+    e = insert_entry(c, key);
+    e->data = malloc(size);
+    memcpy(e->data, data, size);
+    e->size = size;
+    trim_memory(c, size, NULL);
+    c->memory_used += size;
+    mem_push_front(c, e);
+
+    // Oversized frames go straight to the disk tier
+    if (c->memory_used > c->memory_budget) trim_memory(c, 0, NULL);
+    return 1;
+}
+
+int frame_cache_store_canvas(frame_cache_t* c, uint64_t key, canvas_t* canvas) {
+    size_t size = canvas_ppm_size(canvas);
+    unsigned char* data = malloc(size);
+    size = encode_canvas_as_ppm(canvas, data);
+    int ok = frame_cache_store(c, key, data, size);
+    free(data);
+    return ok;
+}
+
+int frame_cache_emit(frame_cache_t* c, uint64_t key, const char* filename) {
+    size_t size;
+    const unsigned char* data = frame_cache_lookup(c, key, &size);
+    if (!data) return 0;
+
+    FILE* file = fopen(filename, "wb");
+    if (!file) {
+        perror("Failed to open file");
+        return 0;
+    }
+    fwrite(data, 1, size, file);
+    fclose(file);
+    return 1;
+}
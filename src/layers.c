@@ -0,0 +1,150 @@
+#include "layers.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+// Row blends: SSE2 four pixels at a time, scalar tail (or whole row without SSE2)
+
+static void blend_row_add(float* restrict dst, const float* restrict src, int n, float opacity) {
+    int x = 0;
+#ifdef __SSE2__
+    const __m128 k = _mm_set1_ps(opacity);
+    for (; x + 4 <= n; x += 4) {
+        __m128 d = _mm_loadu_ps(&dst[x]);
+        _mm_storeu_ps(&dst[x], _mm_add_ps(d, _mm_mul_ps(_mm_loadu_ps(&src[x]), k)));
+    }
+#endif
+    for (; x < n; x++) {
+        dst[x] += src[x] * opacity;
+    }
+}
+
+static void blend_row_max(float* restrict dst, const float* restrict src, int n, float opacity) {
+    int x = 0;
+#ifdef __SSE2__
+    const __m128 k = _mm_set1_ps(opacity);
+    for (; x + 4 <= n; x += 4) {
+        __m128 s = _mm_mul_ps(_mm_loadu_ps(&src[x]), k);
+        _mm_storeu_ps(&dst[x], _mm_max_ps(s, _mm_loadu_ps(&dst[x])));
+    }
+#endif
+    for (; x < n; x++) {
+        float s = src[x] * opacity;
+        dst[x] = s > dst[x] ? s : dst[x];
+    }
+}
+
+static void blend_row_over(float* restrict dst, const float* restrict src, int n, float opacity) {
+    int x = 0;
+#ifdef __SSE2__
+    const __m128 k = _mm_set1_ps(opacity);
+    const __m128 one = _mm_set1_ps(1.0f);
+    for (; x + 4 <= n; x += 4) {
+        __m128 s = _mm_loadu_ps(&src[x]);
+        __m128 alpha = _mm_mul_ps(_mm_min_ps(s, one), k);
+        __m128 d = _mm_mul_ps(_mm_loadu_ps(&dst[x]), _mm_sub_ps(one, alpha));
+        _mm_storeu_ps(&dst[x], _mm_add_ps(_mm_mul_ps(s, k), d));
+    }
+#endif
+    for (; x < n; x++) {
+        float coverage = src[x] < 1.0f ? src[x] : 1.0f;
+        float alpha = coverage * opacity;
+        dst[x] = src[x] * opacity + dst[x] * (1.0f - alpha);
+    }
+}
+
+// out is dense; a sparse layer canvas is read a row at a time through scratch
+static void blend_layer(canvas_t* out, const layer_t* layer, float* scratch) {
+    for (int y = 0; y < out->height; y++) {
+        float* dst = out->pixels[y];
+        const float* src = canvas_row(layer->canvas, y, scratch);
+        switch (layer->blend) {
+            case BLEND_ADD:  blend_row_add(dst, src, out->width, layer->opacity); break;
+            case BLEND_MAX:  blend_row_max(dst, src, out->width, layer->opacity); break;
+            case BLEND_OVER: blend_row_over(dst, src, out->width, layer->opacity); break;
+        }
+    }
+}
+
+layer_stack_t* create_layer_stack(int width, int height) {
+    layer_stack_t* stack = calloc(1, sizeof(layer_stack_t));
+    stack->width = width;
+    stack->height = height;
+    stack->base = create_canvas(width, height);
+    stack->row_scratch = malloc(sizeof(float) * (width > 0 ? width : 1));
+    return stack;
+}
+
+void free_layer_stack(layer_stack_t* stack) {
+    if (!stack) return;
+    for (int i = 0; i < stack->count; i++) {
+        free_canvas(stack->layers[i].canvas);
+    }
+    free_canvas(stack->base);
+    free(stack->row_scratch);
+    free(stack);
+}
+
+layer_t* layer_stack_add(layer_stack_t* stack, const char* name, blend_mode_t blend, int is_static) {
+    if (stack->count >= LAYER_STACK_MAX) return NULL;
+
+    layer_t* layer = &stack->layers[stack->count++];
+    strncpy(layer->name, name, LAYER_NAME_MAX - 1);
+    layer->name[LAYER_NAME_MAX - 1] = '\0';
+    layer->canvas = create_canvas(stack->width, stack->height);
+    layer->blend = blend;
+    layer->opacity = 1.0f;
+    layer->is_static = is_static;
+    stack->base_valid = 0;
+    return layer;
+}
+
+layer_t* layer_stack_find(layer_stack_t* stack, const char* name) {
+    for (int i = 0; i < stack->count; i++) {
+        if (strcmp(stack->layers[i].name, name) == 0) return &stack->layers[i];
+    }
+    return NULL;
+}
+
+void layer_stack_invalidate(layer_stack_t* stack) {
+    stack->base_valid = 0;
+}
+
+void layer_stack_clear_dynamic(layer_stack_t* stack) {
+    for (int i = 0; i < stack->count; i++) {
+        if (!stack->layers[i].is_static) clear_canvas(stack->layers[i].canvas, 0.0f);
+    }
+}
+
+static void rebuild_base(layer_stack_t* stack) {
+    clear_canvas(stack->base, 0.0f);
+    stack->static_prefix = 0;
+    while (stack->static_prefix < stack->count && stack->layers[stack->static_prefix].is_static) {
+        blend_layer(stack->base, &stack->layers[stack->static_prefix], stack->row_scratch);
+        stack->static_prefix++;
+    }
+    stack->base_valid = 1;
+}
+
+int layer_stack_composite(layer_stack_t* stack, canvas_t* out) {
+    if (!out->pixels || out->width != stack->width || out->height != stack->height) {
+        fprintf(stderr, "layer_stack_composite: output must be a dense %dx%d canvas\n",
+                stack->width, stack->height);
+        return 0;
+    }
+    if (!stack->base_valid) rebuild_base(stack);
+
+    size_t row_bytes = sizeof(float) * stack->width;
+    for (int y = 0; y < stack->height; y++) {
+        memcpy(out->pixels[y], stack->base->pixels[y], row_bytes);
+    }
+
+    for (int i = stack->static_prefix; i < stack->count; i++) {
+        blend_layer(out, &stack->layers[i], stack->row_scratch);
+    }
+    return 1;
+}
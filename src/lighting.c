@@ -1,22 +1,42 @@
-#include "lighting.h"
-#include <math.h>
-#define LIGHT_BOOST 2.0f
-float compute_lambert_intensity(vec3_t edge_dir, light_t light) {
-    vec3_t edge_norm = vec3_normalize_fast(edge_dir);
-    vec3_t light_norm = vec3_normalize_fast(light.direction);
-    float dot = vec3_dot(edge_norm, light_norm);
-    float intensity = fmaxf(0.0f, dot) * light.intensity;
-    intensity *= LIGHT_BOOST;
-    if (intensity > 1.0f) intensity = 1.0f;  // clamp
-    return intensity;
-    //return fmaxf(0.0f, dot) * light.intensity;
-}
-
-float compute_lighting_multiple(vec3_t edge_dir, light_t* lights, int light_count) {
-    float total = 0.0f;
-    for (int i = 0; i < light_count && i < MAX_LIGHTS; i++) {
-        total += compute_lambert_intensity(edge_dir, lights[i]);
-    }
-    if (total > 1.0f) total = 1.0f;
-    return total;
-}
+#include "lighting.h"
+#include <math.h>
+#define LIGHT_BOOST 2.0f
+float compute_lambert_intensity(vec3_t edge_dir, light_t light) {
+    return compute_lambert_intensity_xyz(edge_dir.x, edge_dir.y, edge_dir.z, light);
+}
+
+// Same result as compute_lambert_intensity without building vec3_t temporaries
+float compute_lambert_intensity_xyz(float dx, float dy, float dz, light_t light) {
+    float len_sq = dx * dx + dy * dy + dz * dz;
+    if (len_sq >= 1e-8f) {
+        float inv = inv_sqrt_fast(len_sq);
+        dx *= inv;
+        dy *= inv;
+        dz *= inv;
+    }
+
+    float lx = light.direction.x, ly = light.direction.y, lz = light.direction.z;
+    float light_len_sq = lx * lx + ly * ly + lz * lz;
+    if (light_len_sq >= 1e-8f) {
+        float inv = inv_sqrt_fast(light_len_sq);
+        lx *= inv;
+        ly *= inv;
+        lz *= inv;
+    }
+
+    float dot = dx * lx + dy * ly + dz * lz;
+    float intensity = fmaxf(0.0f, dot) * light.intensity;
+    intensity *= LIGHT_BOOST;
+    if (intensity > 1.0f) intensity = 1.0f;  // clamp
+    return intensity;
+    //return fmaxf(0.0f, dot) * light.intensity;
+}
+
+float compute_lighting_multiple(vec3_t edge_dir, light_t* lights, int light_count) {
+    float total = 0.0f;
+    for (int i = 0; i < light_count && i < MAX_LIGHTS; i++) {
+        total += compute_lambert_intensity(edge_dir, lights[i]);
+    }
+    if (total > 1.0f) total = 1.0f;
+    return total;
+}
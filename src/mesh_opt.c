@@ -0,0 +1,175 @@
+#include "mesh_opt.h"
+#include <math.h>
+#include <float.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Spread the low 10 bits of v so there are two zero bits between each
+static unsigned spread_bits(unsigned v) {
+    v &= 0x3ff;
+    v = (v | (v << 16)) & 0x030000ff;
+    v = (v | (v << 8)) & 0x0300f00f;
+    v = (v | (v << 4)) & 0x030c30c3;
+    v = (v | (v << 2)) & 0x09249249;
+    return v;
+}
+
+// 30-bit Morton code of each vertex within the mesh bounds
+static unsigned* morton_codes(const mesh_t* mesh) {
+    float lo[3] = { FLT_MAX, FLT_MAX, FLT_MAX };
+    float hi[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+
+    for (int i = 0; i < mesh->vertex_count; i++) {
+        vec3_t p = mesh->vertices[i].position;
+        lo[0] = fminf(lo[0], p.x); hi[0] = fmaxf(hi[0], p.x);
+        lo[1] = fminf(lo[1], p.y); hi[1] = fmaxf(hi[1], p.y);
+        lo[2] = fminf(lo[2], p.z); hi[2] = fmaxf(hi[2], p.z);
+    }
+
+    float scale[3];
+    for (int a = 0; a < 3; a++) {
+        float extent = hi[a] - lo[a];
+        scale[a] = extent > 0.0f ? 1023.0f / extent : 0.0f;
+    }
+
+    unsigned* codes = malloc(sizeof(unsigned) * mesh->vertex_count);
+    for (int i = 0; i < mesh->vertex_count; i++) {
+        vec3_t p = mesh->vertices[i].position;
+        unsigned x = (unsigned)((p.x - lo[0]) * scale[0]);
+        unsigned y = (unsigned)((p.y - lo[1]) * scale[1]);
+        unsigned z = (unsigned)((p.z - lo[2]) * scale[2]);
+        codes[i] = spread_bits(x) | (spread_bits(y) << 1) | (spread_bits(z) << 2);
+    }
+    return codes;
+}
+
+// Stable LSD radix sort of vertex ids by their Morton code
+static int* sort_by_code(const unsigned* codes, int count) {
+    int* order = malloc(sizeof(int) * count);
+    int* tmp = malloc(sizeof(int) * count);
+    int counts[1 << 10];
+
+    for (int i = 0; i < count; i++) order[i] = i;
+    for (int shift = 0; shift < 30; shift += 10) {
+        memset(counts, 0, sizeof(counts));
+        for (int i = 0; i < count; i++) counts[(codes[order[i]] >> shift) & 0x3ff]++;
+        for (int b = 0, sum = 0; b < (1 << 10); b++) {
+            int c = counts[b];
+            counts[b] = sum;
+            sum += c;
+        }
+        for (int i = 0; i < count; i++) tmp[counts[(codes[order[i]] >> shift) & 0x3ff]++] = order[i];
+        int* swap = order; order = tmp; tmp = swap;
+    }
+    free(tmp);
+    return order;
+}
+
+void mesh_measure_locality(const mesh_t* mesh, float* edge_span, float* edge_jump) {
+    double span = 0.0, jump = 0.0;
+    for (int i = 0; i < mesh->edge_count; i++) {
+        const edge_t* e = &mesh->edges[i];
+        span += abs(e->v1 - e->v0);
+        if (i > 0) jump += abs(e->v0 - mesh->edges[i - 1].v1);
+    }
+    *edge_span = mesh->edge_count > 0 ? (float)(span / mesh->edge_count) : 0.0f;
+    *edge_jump = mesh->edge_count > 1 ? (float)(jump / (mesh->edge_count - 1)) : 0.0f;
+}
+
+mesh_locality_t mesh_optimize_locality(mesh_t* mesh, int reorder_edges) {
+    mesh_locality_t stats;
+    int vc = mesh->vertex_count;
+    int ec = mesh->edge_count;
+
+    mesh_measure_locality(mesh, &stats.edge_span_before, &stats.edge_jump_before);
+    if (vc <= 0) {
+        stats.edge_span_after = stats.edge_span_before;
+        stats.edge_jump_after = stats.edge_jump_before;
+        return stats;
+    }
+
+    // Undirected adjacency in CSR form
+    int* offsets = calloc(vc + 1, sizeof(int));
+    int* adjacency = malloc(sizeof(int) * 2 * (ec > 0 ? ec : 1));
+    for (int i = 0; i < ec; i++) {
+        offsets[mesh->edges[i].v0 + 1]++;
+        offsets[mesh->edges[i].v1 + 1]++;
+    }
+    for (int v = 0; v < vc; v++) offsets[v + 1] += offsets[v];
+    int* fill = malloc(sizeof(int) * vc);
+    memcpy(fill, offsets, sizeof(int) * vc);
+    for (int i = 0; i < ec; i++) {
+        adjacency[fill[mesh->edges[i].v0]++] = mesh->edges[i].v1;
+        adjacency[fill[mesh->edges[i].v1]++] = mesh->edges[i].v0;
+    }
+
+    // BFS from seeds taken in Morton order; new ids are assigned on first visit
+    unsigned* codes = morton_codes(mesh);
+    int* seeds = sort_by_code(codes, vc);
+    int* remap = malloc(sizeof(int) * vc);
+    int* queue = fill; // reuse: the queue holds every vertex exactly once
+    int next_id = 0;
+
+    for (int v = 0; v < vc; v++) remap[v] = -1;
+    for (int s = 0; s < vc; s++) {
+        int seed = seeds[s];
+        if (remap[seed] >= 0) continue;
+
+        int head = next_id, tail = next_id;
+        queue[tail++] = seed;
+        remap[seed] = next_id++;
+        while (head < tail) {
+            int v = queue[head++];
+            for (int k = offsets[v]; k < offsets[v + 1]; k++) {
+                int n = adjacency[k];
+                if (remap[n] < 0) {
+                    remap[n] = next_id++;
+                    queue[tail++] = n;
+                }
+            }
+        }
+    }
+
+    // Apply the vertex permutation
+    vertex_t* vertices = malloc(sizeof(vertex_t) * vc);
+    for (int v = 0; v < vc; v++) vertices[remap[v]] = mesh->vertices[v];
+    free(mesh->vertices);
+    mesh->vertices = vertices;
+    for (int i = 0; i < ec; i++) {
+        mesh->edges[i].v0 = remap[mesh->edges[i].v0];
+        mesh->edges[i].v1 = remap[mesh->edges[i].v1];
+    }
+    for (int i = 0; i < mesh->face_count; i++) {
+        mesh->faces[i].v0 = remap[mesh->faces[i].v0];
+        mesh->faces[i].v1 = remap[mesh->faces[i].v1];
+        mesh->faces[i].v2 = remap[mesh->faces[i].v2];
+    }
+
+    // Stable counting sort of edges by their lower endpoint
+    if (reorder_edges && ec > 0) {
+        int* bucket = calloc(vc + 1, sizeof(int));
+        edge_t* edges = malloc(sizeof(edge_t) * ec);
+        for (int i = 0; i < ec; i++) {
+            const edge_t* e = &mesh->edges[i];
+            bucket[(e->v0 < e->v1 ? e->v0 : e->v1) + 1]++;
+        }
+        for (int v = 0; v < vc; v++) bucket[v + 1] += bucket[v];
+        for (int i = 0; i < ec; i++) {
+            const edge_t* e = &mesh->edges[i];
+            edges[bucket[e->v0 < e->v1 ? e->v0 : e->v1]++] = *e;
+        }
+        free(mesh->edges);
+        mesh->edges = edges;
+        free(bucket);
+    }
+
+    mesh_measure_locality(mesh, &stats.edge_span_after, &stats.edge_jump_after);
+
+    free(offsets);
+    free(adjacency);
+    free(fill);
+    free(codes);
+    free(seeds);
+    free(remap);
+    return stats;
+}
@@ -0,0 +1,411 @@
+#include "renderer.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#define OBJ_MAX_FACE_VERTICES 32
+#define OBJ_MAX_THREADS 64
+#define OBJ_MIN_CHUNK_BYTES (256 * 1024) // Smaller slices aren't worth a thread
+#define OBJ_STREAM_LINE_SIZE 4096 // Initial line buffer, doubled for longer lines
+
+// Read a whole file into a NUL-terminated buffer
+static char* read_file(const char* filename, long* out_size) {
+    FILE* file = fopen(filename, "rb");
+    if (!file) {
+        perror("Failed to open OBJ file");
+        return NULL;
+    }
+
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    char* data = size >= 0 ? malloc(size + 1) : NULL;
+    if (!data || fread(data, 1, size, file) != (size_t)size) {
+        fprintf(stderr, "Failed to read OBJ file '%s'\n", filename);
+        free(data);
+        fclose(file);
+        return NULL;
+    }
+    data[size] = '\0';
+    fclose(file);
+
+    *out_size = size;
+    return data;
+}
+
+static const char* next_line(const char* p, const char* end) {
+    while (p < end && *p != '\n') p++;
+    return p < end ? p + 1 : end;
+}
+
+// Parse up to OBJ_MAX_FACE_VERTICES indices of an "f" record ("f 1 2 3", "f 1/1/1 2/2/2 ...").
+// Relative (negative) indices resolve against vertices_so_far; index 0 is invalid
+// and comes back as -1. Returns the index count.
+static int parse_face(const char* p, const char* end, int vertices_so_far, int* indices) {
+    int count = 0;
+    p += 2;
+    while (p < end && *p != '\n' && count < OBJ_MAX_FACE_VERTICES) {
+        while (p < end && (*p == ' ' || *p == '\t')) p++;
+        if (p >= end || *p == '\n' || *p == '\r') break;
+
+        char* after;
+        long idx = strtol(p, &after, 10);
+        if (after == p) break;
+        if (idx > 0) {
+            indices[count++] = (int)idx - 1;
+        } else if (idx < 0) {
+            indices[count++] = vertices_so_far + (int)idx;
+        } else {
+            indices[count++] = -1;
+        }
+
+        // Skip texture / normal references
+        p = after;
+        while (p < end && *p != ' ' && *p != '\t' && *p != '\n') p++;
+    }
+    return count;
+}
+
+// "v x y z" record (p at the 'v')
+static void parse_vertex(const char* p, vertex_t* vertex) {
+    char* q;
+    float x = strtof(p + 2, &q);
+    float y = strtof(q, &q);
+    float z = strtof(q, &q);
+    vertex->position = vec3_from_cartesian(x, y, z);
+    vertex->intensity = 1.0f;
+}
+
+// Append a face's closed edge loop, skipping pairs outside [0, vertex_count),
+// and its fan triangles if every pair was valid
+static void emit_face(const int* indices, int count, int vertex_count,
+                      edge_t* edges, int* edge_count, face_t* faces, int* face_count) {
+    int valid = 1;
+
+    for (int i = 0; i < count; i++) {
+        int a = indices[i];
+        int b = indices[(i + 1) % count];
+        if (a < 0 || a >= vertex_count || b < 0 || b >= vertex_count) {
+            valid = 0;
+            continue;
+        }
+        edges[*edge_count].v0 = a;
+        edges[*edge_count].v1 = b;
+        edges[*edge_count].depth = 0.0f;
+        (*edge_count)++;
+    }
+
+    for (int i = 1; valid && i + 1 < count; i++) {
+        faces[*face_count].v0 = indices[0];
+        faces[*face_count].v1 = indices[i];
+        faces[*face_count].v2 = indices[i + 1];
+        (*face_count)++;
+    }
+}
+
+mesh_t load_obj_mesh(const char* filename) {
+    mesh_t mesh = {0};
+    long size;
+    char* data = read_file(filename, &size);
+    if (!data) return mesh;
+
+    const char* end = data + size;
+    int indices[OBJ_MAX_FACE_VERTICES];
+    int vertex_count = 0, edge_count = 0, face_count = 0;
+
+    // First pass: count records so everything is allocated once
+    for (const char* p = data; p < end; p = next_line(p, end)) {
+        if (p[0] == 'v' && p[1] == ' ') {
+            vertex_count++;
+        } else if (p[0] == 'f' && p[1] == ' ') {
+            int count = parse_face(p, end, vertex_count, indices);
+            edge_count += count;
+            if (count >= 3) face_count += count - 2;
+        }
+    }
+
+    mesh.vertices = malloc(sizeof(vertex_t) * (vertex_count > 0 ? vertex_count : 1));
+    mesh.edges = malloc(sizeof(edge_t) * (edge_count > 0 ? edge_count : 1));
+    mesh.faces = malloc(sizeof(face_t) * (face_count > 0 ? face_count : 1));
+
+    // Second pass: vertices, closed edge loops and fan-triangulated faces
+    for (const char* p = data; p < end; p = next_line(p, end)) {
+        if (p[0] == 'v' && p[1] == ' ') {
+            parse_vertex(p, &mesh.vertices[mesh.vertex_count]);
+            mesh.vertex_count++;
+        } else if (p[0] == 'f' && p[1] == ' ') {
+            int count = parse_face(p, end, mesh.vertex_count, indices);
+            emit_face(indices, count, vertex_count, mesh.edges, &mesh.edge_count, mesh.faces, &mesh.face_count);
+        }
+    }
+
+    free(data);
+    return mesh;
+}
+
+// ---------------- Parallel load ----------------
+
+// One newline-aligned slice of the file. Lines are read up to end, but record
+// parsing may look past it exactly as the serial loader does (to data_end).
+typedef struct {
+    const char* begin;
+    const char* end;
+    const char* data_end;
+
+    // Pass 1: record counts (edges and faces before validation)
+    int vertices;
+    int raw_edges;
+    int raw_faces;
+
+    // Prefix sums over earlier chunks
+    int vertex_base;
+    int edge_base;
+    int face_base;
+
+    // Pass 2: output written at the bases
+    mesh_t* mesh;
+    int vertex_total;
+    int edges_written;
+    int faces_written;
+} obj_chunk_t;
+
+static void* count_chunk(void* arg) {
+    obj_chunk_t* chunk = arg;
+    int indices[OBJ_MAX_FACE_VERTICES];
+
+    for (const char* p = chunk->begin; p < chunk->end; p = next_line(p, chunk->data_end)) {
+        if (p[0] == 'v' && p[1] == ' ') {
+            chunk->vertices++;
+        } else if (p[0] == 'f' && p[1] == ' ') {
+            int count = parse_face(p, chunk->data_end, 0, indices);
+            chunk->raw_edges += count;
+            if (count >= 3) chunk->raw_faces += count - 2;
+        }
+    }
+    return NULL;
+}
+
+static void* parse_chunk(void* arg) {
+    obj_chunk_t* chunk = arg;
+    mesh_t* mesh = chunk->mesh;
+    edge_t* edges = mesh->edges + chunk->edge_base;
+    face_t* faces = mesh->faces + chunk->face_base;
+    int indices[OBJ_MAX_FACE_VERTICES];
+    int vertices = chunk->vertex_base;
+
+    for (const char* p = chunk->begin; p < chunk->end; p = next_line(p, chunk->data_end)) {
+        if (p[0] == 'v' && p[1] == ' ') {
+            parse_vertex(p, &mesh->vertices[vertices]);
+            vertices++;
+        } else if (p[0] == 'f' && p[1] == ' ') {
+            // Relative indices resolve against the global vertex count so far
+            int count = parse_face(p, chunk->data_end, vertices, indices);
+            emit_face(indices, count, chunk->vertex_total, edges, &chunk->edges_written,
+                      faces, &chunk->faces_written);
+        }
+    }
+    return NULL;
+}
+
+// Run fn over every chunk, one thread each (the first on the calling thread)
+static void run_chunks(obj_chunk_t* chunks, int chunk_count, void* (*fn)(void*)) {
+    pthread_t threads[OBJ_MAX_THREADS];
+    int started[OBJ_MAX_THREADS] = {0};
+
+    for (int i = 1; i < chunk_count; i++) {
+        started[i] = pthread_create(&threads[i], NULL, fn, &chunks[i]) == 0;
+        if (!started[i]) fn(&chunks[i]);
+    }
+    fn(&chunks[0]);
+    for (int i = 1; i < chunk_count; i++) {
+        if (started[i]) pthread_join(threads[i], NULL);
+    }
+}
+
+mesh_t load_obj_mesh_parallel(const char* filename, int thread_count) {
+    mesh_t mesh = {0};
+    long size;
+    char* data = read_file(filename, &size);
+    if (!data) return mesh;
+
+    if (thread_count <= 0) thread_count = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if (thread_count > OBJ_MAX_THREADS) thread_count = OBJ_MAX_THREADS;
+    long max_chunks = size / OBJ_MIN_CHUNK_BYTES + 1;
+    int chunk_count = thread_count < max_chunks ? thread_count : (int)max_chunks;
+    if (chunk_count < 1) chunk_count = 1;
+
+    // Split at line starts near equal byte offsets
+    const char* end = data + size;
+    obj_chunk_t chunks[OBJ_MAX_THREADS];
+    memset(chunks, 0, sizeof(chunks));
+    const char* begin = data;
+    for (int i = 0; i < chunk_count; i++) {
+        const char* split = i + 1 < chunk_count ? data + size / chunk_count * (i + 1) : end;
+        if (split < begin) split = begin;
+        if (split > data && split < end) split = next_line(split - 1, end);
+        chunks[i].begin = begin;
+        chunks[i].end = split;
+        chunks[i].data_end = end;
+        begin = split;
+    }
+
+    run_chunks(chunks, chunk_count, count_chunk);
+
+    int vertex_count = 0, edge_count = 0, face_count = 0;
+    for (int i = 0; i < chunk_count; i++) {
+        chunks[i].vertex_base = vertex_count;
+        chunks[i].edge_base = edge_count;
+        chunks[i].face_base = face_count;
+        vertex_count += chunks[i].vertices;
+        edge_count += chunks[i].raw_edges;
+        face_count += chunks[i].raw_faces;
+    }
+
+    mesh.vertices = malloc(sizeof(vertex_t) * (vertex_count > 0 ? vertex_count : 1));
+    mesh.edges = malloc(sizeof(edge_t) * (edge_count > 0 ? edge_count : 1));
+    mesh.faces = malloc(sizeof(face_t) * (face_count > 0 ? face_count : 1));
+    for (int i = 0; i < chunk_count; i++) {
+        chunks[i].mesh = &mesh;
+        chunks[i].vertex_total = vertex_count;
+    }
+
+    run_chunks(chunks, chunk_count, parse_chunk);
+
+    // Close the gaps left by rejected edges and faces (in order, so moves only go down)
+    mesh.vertex_count = vertex_count;
+    for (int i = 0; i < chunk_count; i++) {
+        if (mesh.edge_count != chunks[i].edge_base) {
+            memmove(mesh.edges + mesh.edge_count, mesh.edges + chunks[i].edge_base,
+                    sizeof(edge_t) * chunks[i].edges_written);
+        }
+        if (mesh.face_count != chunks[i].face_base) {
+            memmove(mesh.faces + mesh.face_count, mesh.faces + chunks[i].face_base,
+                    sizeof(face_t) * chunks[i].faces_written);
+        }
+        mesh.edge_count += chunks[i].edges_written;
+        mesh.face_count += chunks[i].faces_written;
+    }
+
+    free(data);
+    return mesh;
+}
+
+// ---------------- Streaming render ----------------
+
+typedef struct {
+    edge_t* edges;
+    int count;
+    int capacity;
+} edge_buffer_t;
+
+static void edge_buffer_push(edge_buffer_t* buffer, int v0, int v1) {
+    if (buffer->count == buffer->capacity) {
+        buffer->capacity = buffer->capacity ? buffer->capacity * 2 : 256;
+        buffer->edges = realloc(buffer->edges, sizeof(edge_t) * buffer->capacity);
+    }
+    buffer->edges[buffer->count].v0 = v0;
+    buffer->edges[buffer->count].v1 = v1;
+    buffer->edges[buffer->count].depth = 0.0f;
+    buffer->count++;
+}
+
+// Read a whole line into *line, growing it as needed. Returns 0 at end of file.
+static int read_line(FILE* file, char** line, size_t* capacity) {
+    if (!fgets(*line, (int)*capacity, file)) return 0;
+    size_t length = strlen(*line);
+    while (length + 1 == *capacity && (*line)[length - 1] != '\n') {
+        *capacity *= 2;
+        *line = realloc(*line, *capacity);
+        if (!fgets(*line + length, (int)(*capacity - length), file)) break;
+        length += strlen(*line + length);
+    }
+    return 1;
+}
+
+// Render an OBJ wireframe in one pass without building a mesh_t. Vertices are
+// projected as they are read into a packed xyz store; face edges are batched
+// into a fixed chunk and drawn as soon as it fills. Edges that reference a
+// vertex not read yet are held back and drawn at the end; that list is not
+// bounded and grows with the number of forward references in the file.
+// Returns the number of edges rendered, or -1 if the file cannot be opened.
+int render_obj_streaming(canvas_t* canvas, const char* filename, mat4_t transform,
+                         const render_setup_t* setup, int chunk_edges) {
+    FILE* file = fopen(filename, "r");
+    if (!file) {
+        perror("Failed to open OBJ file");
+        return -1;
+    }
+    if (chunk_edges < OBJ_MAX_FACE_VERTICES) chunk_edges = OBJ_MAX_FACE_VERTICES;
+
+    float* xyz = NULL;
+    int vertex_count = 0, vertex_capacity = 0;
+    edge_t* chunk = malloc(sizeof(edge_t) * chunk_edges);
+    int chunk_count = 0;
+    edge_buffer_t deferred = {0};
+    int rendered = 0;
+    int indices[OBJ_MAX_FACE_VERTICES];
+    size_t line_capacity = OBJ_STREAM_LINE_SIZE;
+    char* line = malloc(line_capacity);
+
+    while (read_line(file, &line, &line_capacity)) {
+        if (line[0] == 'v' && line[1] == ' ') {
+            if (vertex_count == vertex_capacity) {
+                vertex_capacity = vertex_capacity ? vertex_capacity * 2 : 1024;
+                xyz = realloc(xyz, sizeof(float) * 3 * vertex_capacity);
+            }
+            char* q;
+            float in[3];
+            in[0] = strtof(line + 2, &q);
+            in[1] = strtof(q, &q);
+            in[2] = strtof(q, &q);
+            mat4_transform_point(transform, in, &xyz[vertex_count * 3]);
+            vertex_count++;
+        } else if (line[0] == 'f' && line[1] == ' ') {
+            int count = parse_face(line, line + strlen(line), vertex_count, indices);
+
+            // Make room for the whole face so a face never straddles two flushes
+            if (chunk_count + count > chunk_edges) {
+                render_edges(canvas, setup, xyz, chunk, chunk_count);
+                rendered += chunk_count;
+                chunk_count = 0;
+            }
+
+            for (int i = 0; i < count; i++) {
+                int a = indices[i];
+                int b = indices[(i + 1) % count];
+                if (a < 0 || b < 0) continue;
+                if (a >= vertex_count || b >= vertex_count) {
+                    edge_buffer_push(&deferred, a, b);
+                    continue;
+                }
+                chunk[chunk_count].v0 = a;
+                chunk[chunk_count].v1 = b;
+                chunk[chunk_count].depth = 0.0f;
+                chunk_count++;
+            }
+        }
+    }
+    fclose(file);
+    free(line);
+
+    render_edges(canvas, setup, xyz, chunk, chunk_count);
+    rendered += chunk_count;
+
+    // Forward references: keep the ones that resolved once the file was read
+    chunk_count = 0;
+    for (int i = 0; i < deferred.count; i++) {
+        if (deferred.edges[i].v0 < vertex_count && deferred.edges[i].v1 < vertex_count) {
+            deferred.edges[chunk_count++] = deferred.edges[i];
+        }
+    }
+    render_edges(canvas, setup, xyz, deferred.edges, chunk_count);
+    rendered += chunk_count;
+
+    free(xyz);
+    free(chunk);
+    free(deferred.edges);
+    return rendered;
+}
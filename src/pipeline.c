@@ -0,0 +1,168 @@
+#define _POSIX_C_SOURCE 200809L // nanosleep, posix_memalign
+#include "pipeline.h"
+#include "t3z.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sched.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#define SPIN_BEFORE_SLEEP 64
+
+// ---------------- SPSC ring ----------------
+
+static void ring_init(spsc_ring_t* ring) {
+    atomic_init(&ring->head, 0);
+    atomic_init(&ring->tail, 0);
+}
+
+// Producer side. The ring never holds more than PIPELINE_MAX_FRAMES slots,
+// so a push cannot overflow.
+static void ring_push(spsc_ring_t* ring, int slot) {
+    unsigned tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+    ring->slots[tail % PIPELINE_MAX_FRAMES] = slot;
+    atomic_store_explicit(&ring->tail, tail + 1, memory_order_release);
+}
+
+// Consumer side. Returns -1 when empty.
+static int ring_pop(spsc_ring_t* ring) {
+    unsigned head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    if (head == atomic_load_explicit(&ring->tail, memory_order_acquire)) return -1;
+    int slot = ring->slots[head % PIPELINE_MAX_FRAMES];
+    atomic_store_explicit(&ring->head, head + 1, memory_order_release);
+    return slot;
+}
+
+// Back off while waiting on the other stage: spin briefly, then sleep
+static void backoff(int* spins) {
+    if (++*spins < SPIN_BEFORE_SLEEP) {
+        sched_yield();
+    } else {
+        struct timespec ts = { 0, 50000 }; // 50 us
+        nanosleep(&ts, NULL);
+    }
+}
+
+// ---------------- Writer thread ----------------
+
+static int write_all(const char* filename, const unsigned char* data, size_t size) {
+    int fd = open(filename, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        perror("Failed to open file");
+        return 0;
+    }
+    while (size > 0) {
+        ssize_t n = write(fd, data, size);
+        if (n <= 0) {
+            perror("Failed to write frame");
+            close(fd);
+            return 0;
+        }
+        data += n;
+        size -= (size_t)n;
+    }
+    close(fd);
+    return 1;
+}
+
+static void* writer_main(void* arg) {
+    frame_pipeline_t* p = arg;
+    int spins = 0;
+
+    for (;;) {
+        int slot = ring_pop(&p->full_ring);
+        if (slot < 0) {
+            if (atomic_load(&p->running)) {
+                backoff(&spins);
+                continue;
+            }
+            // running is cleared after the last submit, so one more look drains the queue
+            slot = ring_pop(&p->full_ring);
+            if (slot < 0) break;
+        }
+        spins = 0;
+
+        frame_slot_t* frame = &p->frames[slot];
+        size_t size = is_t3z_filename(frame->filename)
+                    ? encode_canvas_as_t3z(frame->canvas, p->encode_buffer)
+                    : encode_canvas_as_ppm(frame->canvas, p->encode_buffer);
+        if (size && write_all(frame->filename, p->encode_buffer, size)) {
+            atomic_fetch_add(&p->frames_written, 1);
+        } else {
+            atomic_fetch_add(&p->write_errors, 1);
+        }
+
+        ring_push(&p->free_ring, slot);
+    }
+    return NULL;
+}
+
+// ---------------- Public API ----------------
+
+frame_pipeline_t* frame_pipeline_create(int width, int height, int pool_size) {
+    if (pool_size < 2) pool_size = 2;
+    if (pool_size > PIPELINE_MAX_FRAMES) pool_size = PIPELINE_MAX_FRAMES;
+
+    // The rings are cache-line aligned, so the pipeline itself must be too
+    size_t size = (sizeof(frame_pipeline_t) + 63) & ~(size_t)63;
+    frame_pipeline_t* p;
+    if (posix_memalign((void**)&p, 64, size) != 0) return NULL;
+    memset(p, 0, size);
+
+    ring_init(&p->free_ring);
+    ring_init(&p->full_ring);
+    p->frame_count = pool_size;
+    for (int i = 0; i < pool_size; i++) {
+        p->frames[i].canvas = create_canvas(width, height);
+        ring_push(&p->free_ring, i);
+    }
+    size_t ppm_size = canvas_ppm_size(p->frames[0].canvas);
+    size_t t3z_size = canvas_t3z_max_size(p->frames[0].canvas);
+    p->encode_buffer = malloc(ppm_size > t3z_size ? ppm_size : t3z_size);
+    atomic_init(&p->running, 1);
+    atomic_init(&p->frames_written, 0);
+    atomic_init(&p->render_stalls, 0);
+    atomic_init(&p->write_errors, 0);
+
+    if (pthread_create(&p->writer, NULL, writer_main, p) != 0) {
+        fprintf(stderr, "Failed to start frame writer thread\n");
+        for (int i = 0; i < pool_size; i++) free_canvas(p->frames[i].canvas);
+        free(p->encode_buffer);
+        free(p);
+        return NULL;
+    }
+    return p;
+}
+
+canvas_t* frame_pipeline_acquire(frame_pipeline_t* p) {
+    int spins = 0;
+    int slot = ring_pop(&p->free_ring);
+    if (slot < 0) {
+        atomic_fetch_add(&p->render_stalls, 1);
+        while ((slot = ring_pop(&p->free_ring)) < 0) backoff(&spins);
+    }
+    return p->frames[slot].canvas;
+}
+
+void frame_pipeline_submit(frame_pipeline_t* p, canvas_t* canvas, const char* filename) {
+    for (int i = 0; i < p->frame_count; i++) {
+        if (p->frames[i].canvas == canvas) {
+            snprintf(p->frames[i].filename, PIPELINE_FILENAME_MAX, "%s", filename);
+            ring_push(&p->full_ring, i);
+            return;
+        }
+    }
+    fprintf(stderr, "frame_pipeline_submit: canvas does not belong to this pipeline\n");
+}
+
+void frame_pipeline_destroy(frame_pipeline_t* p) {
+    if (!p) return;
+    atomic_store(&p->running, 0);
+    pthread_join(p->writer, NULL);
+
+    for (int i = 0; i < p->frame_count; i++) free_canvas(p->frames[i].canvas);
+    free(p->encode_buffer);
+    free(p);
+}
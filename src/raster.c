@@ -0,0 +1,205 @@
+#include "raster.h"
+#include <math.h>
+#include <float.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#define RASTER_COLOR 1 // Write intensity
+#define RASTER_DEPTH 2 // Depth test and depth write
+
+// Half-space edge function E(x, y) = a*x + b*y + c, positive inside
+typedef struct {
+    float a, b, c;
+    float bias; // 0 for top-left edges, otherwise a tiny positive value (fill rule)
+} edge_fn_t;
+
+static float min3(float a, float b, float c) {
+    return fminf(a, fminf(b, c));
+}
+
+static float max3(float a, float b, float c) {
+    return fmaxf(a, fmaxf(b, c));
+}
+
+static void setup_edge(edge_fn_t* e, float xa, float ya, float xb, float yb) {
+    e->a = ya - yb;
+    e->b = xb - xa;
+    e->c = xa * yb - xb * ya;
+
+    // Top-left rule for a counter-clockwise (positive area) triangle
+    int top = (ya == yb) && (xb < xa);
+    int left = yb < ya;
+    e->bias = (top || left) ? 0.0f : FLT_MIN;
+}
+
+static float eval_edge(const edge_fn_t* e, float x, float y) {
+    return e->a * x + e->b * y + e->c;
+}
+
+// Scalar path for one pixel. *color is the span's row pointer, fetched on the
+// first covered pixel so sparse canvases only allocate tiles that get drawn.
+static void shade_pixel(canvas_t* canvas, float** color, int x0, int x, int y, float z, float intensity, int mode) {
+    if (mode & RASTER_DEPTH) {
+        if (!(z < canvas->depth[y][x])) return;
+        canvas->depth[y][x] = z;
+    }
+    if (mode & RASTER_COLOR) {
+        if (!*color) *color = canvas_pixel_ptr(canvas, x0, y);
+        (*color)[x - x0] = intensity;
+    }
+}
+
+// Fill one row span [x0, x1) of a block, evaluating the edge functions incrementally.
+// Blocks are aligned to RASTER_BLOCK, so a span never crosses a canvas tile.
+static void raster_span(canvas_t* canvas, const edge_fn_t* e, int x0, int x1, int y,
+                        float zx, float zy, float zc, float intensity, int mode, int inside) {
+    float px = x0 + 0.5f;
+    float py = y + 0.5f;
+    float e0 = eval_edge(&e[0], px, py);
+    float e1 = eval_edge(&e[1], px, py);
+    float e2 = eval_edge(&e[2], px, py);
+    float z = zx * px + zy * py + zc;
+    float* color = NULL;
+    int x = x0;
+
+#ifdef __SSE2__
+    if (x1 - x >= 4) {
+        const __m128 step = _mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f);
+        __m128 ve0 = _mm_add_ps(_mm_set1_ps(e0), _mm_mul_ps(step, _mm_set1_ps(e[0].a)));
+        __m128 ve1 = _mm_add_ps(_mm_set1_ps(e1), _mm_mul_ps(step, _mm_set1_ps(e[1].a)));
+        __m128 ve2 = _mm_add_ps(_mm_set1_ps(e2), _mm_mul_ps(step, _mm_set1_ps(e[2].a)));
+        __m128 vz = _mm_add_ps(_mm_set1_ps(z), _mm_mul_ps(step, _mm_set1_ps(zx)));
+        const __m128 de0 = _mm_set1_ps(4.0f * e[0].a);
+        const __m128 de1 = _mm_set1_ps(4.0f * e[1].a);
+        const __m128 de2 = _mm_set1_ps(4.0f * e[2].a);
+        const __m128 dz = _mm_set1_ps(4.0f * zx);
+        const __m128 b0 = _mm_set1_ps(e[0].bias);
+        const __m128 b1 = _mm_set1_ps(e[1].bias);
+        const __m128 b2 = _mm_set1_ps(e[2].bias);
+        const __m128 shade = _mm_set1_ps(intensity);
+
+        for (; x + 4 <= x1; x += 4) {
+            __m128 mask = inside ? _mm_castsi128_ps(_mm_set1_epi32(-1))
+                                 : _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(ve0, b0), _mm_cmpge_ps(ve1, b1)),
+                                              _mm_cmpge_ps(ve2, b2));
+            if (mode & RASTER_DEPTH) {
+                __m128 old_z = _mm_loadu_ps(&canvas->depth[y][x]);
+                mask = _mm_and_ps(mask, _mm_cmplt_ps(vz, old_z));
+                _mm_storeu_ps(&canvas->depth[y][x],
+                              _mm_or_ps(_mm_and_ps(mask, vz), _mm_andnot_ps(mask, old_z)));
+            }
+            if ((mode & RASTER_COLOR) && _mm_movemask_ps(mask)) {
+                if (!color) color = canvas_pixel_ptr(canvas, x0, y);
+                __m128 old_c = _mm_loadu_ps(&color[x - x0]);
+                _mm_storeu_ps(&color[x - x0],
+                              _mm_or_ps(_mm_and_ps(mask, shade), _mm_andnot_ps(mask, old_c)));
+            }
+
+            ve0 = _mm_add_ps(ve0, de0);
+            ve1 = _mm_add_ps(ve1, de1);
+            ve2 = _mm_add_ps(ve2, de2);
+            vz = _mm_add_ps(vz, dz);
+        }
+
+        int done = x - x0;
+        e0 += done * e[0].a;
+        e1 += done * e[1].a;
+        e2 += done * e[2].a;
+        z += done * zx;
+    }
+#endif
+
+    for (; x < x1; x++) {
+        if (inside || (e0 >= e[0].bias && e1 >= e[1].bias && e2 >= e[2].bias)) {
+            shade_pixel(canvas, &color, x0, x, y, z, intensity, mode);
+        }
+        e0 += e[0].a;
+        e1 += e[1].a;
+        e2 += e[2].a;
+        z += zx;
+    }
+}
+
+static void raster_triangle(canvas_t* canvas,
+                            float x0, float y0, float z0,
+                            float x1, float y1, float z1,
+                            float x2, float y2, float z2,
+                            float intensity, int mode) {
+    float area = (x1 - x0) * (y2 - y0) - (y1 - y0) * (x2 - x0);
+    if (fabsf(area) < 1e-12f || !isfinite(area)) return;
+
+    // Make the winding counter-clockwise so "inside" is always positive
+    if (area < 0.0f) {
+        float tx = x1, ty = y1, tz = z1;
+        x1 = x2; y1 = y2; z1 = z2;
+        x2 = tx; y2 = ty; z2 = tz;
+        area = -area;
+    }
+
+    edge_fn_t e[3];
+    setup_edge(&e[0], x1, y1, x2, y2); // opposite v0
+    setup_edge(&e[1], x2, y2, x0, y0); // opposite v1
+    setup_edge(&e[2], x0, y0, x1, y1); // opposite v2
+
+    // Depth plane z = zx*x + zy*y + zc from the barycentric weights
+    float inv_area = 1.0f / area;
+    float zx = (e[0].a * z0 + e[1].a * z1 + e[2].a * z2) * inv_area;
+    float zy = (e[0].b * z0 + e[1].b * z1 + e[2].b * z2) * inv_area;
+    float zc = (e[0].c * z0 + e[1].c * z1 + e[2].c * z2) * inv_area;
+
+    // Bounding box clamped to the canvas, then snapped to the block grid
+    int min_x = (int)fmaxf(floorf(min3(x0, x1, x2)), 0.0f);
+    int min_y = (int)fmaxf(floorf(min3(y0, y1, y2)), 0.0f);
+    int max_x = (int)fminf(ceilf(max3(x0, x1, x2)), (float)(canvas->width - 1));
+    int max_y = (int)fminf(ceilf(max3(y0, y1, y2)), (float)(canvas->height - 1));
+    if (min_x > max_x || min_y > max_y) return;
+
+    min_x &= ~(RASTER_BLOCK - 1);
+    min_y &= ~(RASTER_BLOCK - 1);
+
+    for (int by = min_y; by <= max_y; by += RASTER_BLOCK) {
+        int y_end = by + RASTER_BLOCK <= max_y + 1 ? by + RASTER_BLOCK : max_y + 1;
+        for (int bx = min_x; bx <= max_x; bx += RASTER_BLOCK) {
+            int x_end = bx + RASTER_BLOCK <= max_x + 1 ? bx + RASTER_BLOCK : max_x + 1;
+
+            // Edge functions are linear, so the block's extremes are at its corner samples
+            float cx0 = bx + 0.5f, cx1 = bx + RASTER_BLOCK - 0.5f;
+            float cy0 = by + 0.5f, cy1 = by + RASTER_BLOCK - 0.5f;
+            int inside = 1, outside = 0;
+            for (int k = 0; k < 3; k++) {
+                float c00 = eval_edge(&e[k], cx0, cy0);
+                float c10 = eval_edge(&e[k], cx1, cy0);
+                float c01 = eval_edge(&e[k], cx0, cy1);
+                float c11 = eval_edge(&e[k], cx1, cy1);
+                float lo = fminf(fminf(c00, c10), fminf(c01, c11));
+                float hi = fmaxf(fmaxf(c00, c10), fmaxf(c01, c11));
+                if (hi < e[k].bias) outside = 1;
+                if (lo < e[k].bias) inside = 0;
+            }
+            if (outside) continue;
+
+            for (int y = by; y < y_end; y++) {
+                raster_span(canvas, e, bx, x_end, y, zx, zy, zc, intensity, mode, inside);
+            }
+        }
+    }
+}
+
+void rasterize_triangle_depth(canvas_t* canvas,
+                              float x0, float y0, float z0,
+                              float x1, float y1, float z1,
+                              float x2, float y2, float z2) {
+    if (!canvas->depth) return;
+    raster_triangle(canvas, x0, y0, z0, x1, y1, z1, x2, y2, z2, 0.0f, RASTER_DEPTH);
+}
+
+void fill_triangle_f(canvas_t* canvas,
+                     float x0, float y0, float z0,
+                     float x1, float y1, float z1,
+                     float x2, float y2, float z2,
+                     float intensity) {
+    int mode = RASTER_COLOR | (canvas->depth ? RASTER_DEPTH : 0);
+    raster_triangle(canvas, x0, y0, z0, x1, y1, z1, x2, y2, z2, intensity, mode);
+}
@@ -1,110 +1,415 @@
-#include "renderer.h"
-#include "lighting.h"
-#include "canvas.h"
-#include <math.h>
-#include <stdio.h>
-#include <stdlib.h>
-#include <string.h>
-
-// Light setup (global or can be passed)
-static light_t scene_light = {
-    .direction = { .x = 0.5f, .y = 0.5f, .z = -1.0f },  // Diagonal light
-    .intensity = 1.0f
-};
-
-// Apply full transformation to vertex, including projection
-void project_vertex(vertex_t* vertex, mat4_t transform) {
-    vertex->position = mat4_transform_vec3(transform, vertex->position);
-}
-
-// Clip point to circular viewport
-int clip_to_circular_viewport(canvas_t* canvas, float x, float y) {
-    float cx = canvas->width / 2.0f;
-    float cy = canvas->height / 2.0f;
-    float radius = fminf(cx, cy) * 0.9f;
-    float dx = x - cx;
-    float dy = y - cy;
-    return (dx * dx + dy * dy) <= (radius * radius);
-}
-
-// Free memory associated with mesh
-void free_mesh(mesh_t* mesh) {
-    if (mesh) {
-        if (mesh->vertices) free(mesh->vertices);
-        if (mesh->edges) free(mesh->edges);
-        mesh->vertex_count = 0;
-        mesh->edge_count = 0;
-    }
-}
-
-// Main wireframe rendering function (with lighting)
-void render_wireframe(canvas_t* canvas, mesh_t* mesh, mat4_t transform) {
-    // Step 1: Project all vertices
-    for (int i = 0; i < mesh->vertex_count; i++) {
-        project_vertex(&mesh->vertices[i], transform);
-    }
-
-    // Step 2: Draw all edges with lighting
-    for (int i = 0; i < mesh->edge_count; i++) {
-        vertex_t* v0 = &mesh->vertices[mesh->edges[i].v0];
-        vertex_t* v1 = &mesh->vertices[mesh->edges[i].v1];
-
-        // Convert to screen space
-        float x0 = v0->position.x * canvas->width * 0.4f + canvas->width / 2;
-        float y0 = v0->position.y * canvas->height * 0.4f + canvas->height / 2;
-        float x1 = v1->position.x * canvas->width * 0.4f + canvas->width / 2;
-        float y1 = v1->position.y * canvas->height * 0.4f + canvas->height / 2;
-
-        if (clip_to_circular_viewport(canvas, x0, y0) &&
-            clip_to_circular_viewport(canvas, x1, y1)) {
-
-            // Compute direction from v0 to v1 for lighting
-            vec3_t edge_dir = vec3_subtract(v1->position, v0->position);
-            float brightness = compute_lambert_intensity(edge_dir, scene_light);
-
-            // Optional: clamp brightness to avoid invisible lines
-            if (brightness < 0.05f) brightness = 0.05f;
-
-            // Use brightness to scale line thickness or intensity
-            draw_line_f(canvas, x0, y0, x1, y1, 1.5f * brightness);
-        }
-    }
-}
-
-// Create a cube mesh centered at origin
-mesh_t create_cube_mesh(float size) {
-    float s = size / 2.0f;
-
-    mesh_t mesh;
-    mesh.vertex_count = 8;
-    mesh.edge_count = 12;
-    mesh.vertices = malloc(sizeof(vertex_t) * mesh.vertex_count);
-    mesh.edges = malloc(sizeof(edge_t) * mesh.edge_count);
-
-    // Cube vertices (same order as your cube wireframe)
-    vec3_t positions[8] = {
-        {-s, -s, -s}, {s, -s, -s}, {s, s, -s}, {-s, s, -s},
-        {-s, -s,  s}, {s, -s,  s}, {s, s,  s}, {-s, s,  s}
-    };
-
-    for (int i = 0; i < 8; i++) {
-        mesh.vertices[i].position = positions[i];
-        mesh.vertices[i].intensity = 1.0f; // optional
-    }
-
-    // Cube edges
-    int edge_indices[12][2] = {
-        {0,1},{1,2},{2,3},{3,0}, // back face
-        {4,5},{5,6},{6,7},{7,4}, // front face
-        {0,4},{1,5},{2,6},{3,7}  // vertical
-    };
-
-    for (int i = 0; i < 12; i++) {
-        mesh.edges[i].v0 = edge_indices[i][0];
-        mesh.edges[i].v1 = edge_indices[i][1];
-        mesh.edges[i].depth = 0.0f; // unused
-    }
-
-    return mesh;
-}
-
+#include "renderer.h"
+#include "lighting.h"
+#include "canvas.h"
+#include "raster.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Light setup (global or can be passed)
+static light_t scene_light = {
+    .direction = { .x = 0.5f, .y = 0.5f, .z = -1.0f },  // Diagonal light
+    .intensity = 1.0f
+};
+
+// Apply full transformation to vertex, including projection
+void project_vertex(vertex_t* vertex, mat4_t transform) {
+    vertex->position = mat4_transform_vec3(transform, vertex->position);
+}
+
+// Clip point to circular viewport
+int clip_to_circular_viewport(canvas_t* canvas, float x, float y) {
+    float cx = canvas->width / 2.0f;
+    float cy = canvas->height / 2.0f;
+    float radius = fminf(cx, cy) * 0.9f;
+    float dx = x - cx;
+    float dy = y - cy;
+    return (dx * dx + dy * dy) <= (radius * radius);
+}
+
+// Map normalized projected coordinates to canvas pixels (same framing as render_wireframe)
+void ndc_to_screen(canvas_t* canvas, float nx, float ny, float* sx, float* sy) {
+    *sx = nx * canvas->width * 0.4f + canvas->width / 2;
+    *sy = ny * canvas->height * 0.4f + canvas->height / 2;
+}
+
+// Lighting for one projected edge direction using the scene light
+float compute_edge_brightness(vec3_t edge_dir) {
+    float brightness = compute_lambert_intensity(edge_dir, scene_light);
+
+    // Optional: clamp brightness to avoid invisible lines
+    if (brightness < 0.05f) brightness = 0.05f;
+    return brightness;
+}
+
+// Same as compute_edge_brightness for the direction p0 -> p1 of packed xyz points
+float compute_edge_brightness_xyz(const float* p0, const float* p1) {
+    float brightness = compute_lambert_intensity_xyz(p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2], scene_light);
+    if (brightness < 0.05f) brightness = 0.05f;
+    return brightness;
+}
+
+// ---------------- Specialized edge loops ----------------
+
+// Each combination of options gets its own loop; the option tests below are
+// compile-time constants, so the per-edge loop has no runtime option branches.
+// BRIGHTNESS is the per-edge lighting expression (p0, p1 and i are in scope).
+#define EDGE_LOOP_BODY(BRIGHTNESS, VIEWPORT, VARIABLE)                                           \
+    float width = (float)canvas->width, height = (float)canvas->height;                         \
+    int half_w = canvas->width / 2, half_h = canvas->height / 2;                                 \
+    float cx = canvas->width / 2.0f, cy = canvas->height / 2.0f;                                 \
+    float radius = fminf(cx, cy) * 0.9f;                                                         \
+    float radius_sq = radius * radius;                                                           \
+    float rx0 = config->rect_x0, ry0 = config->rect_y0;                                          \
+    float rx1 = config->rect_x1, ry1 = config->rect_y1;                                          \
+    float thickness = config->thickness;                                                         \
+    (void)radius_sq; (void)rx0; (void)ry0; (void)rx1; (void)ry1;                                 \
+                                                                                                 \
+    for (int i = 0; i < count; i++) {                                                            \
+        const float* p0 = &xyz[edges[i].v0 * 3];                                                 \
+        const float* p1 = &xyz[edges[i].v1 * 3];                                                 \
+        float x0 = p0[0] * width * 0.4f + half_w;                                                \
+        float y0 = p0[1] * height * 0.4f + half_h;                                               \
+        float x1 = p1[0] * width * 0.4f + half_w;                                                \
+        float y1 = p1[1] * height * 0.4f + half_h;                                               \
+                                                                                                 \
+        if (VIEWPORT == VIEWPORT_CIRCLE) {                                                       \
+            float dx0 = x0 - cx, dy0 = y0 - cy, dx1 = x1 - cx, dy1 = y1 - cy;                    \
+            if (!(dx0 * dx0 + dy0 * dy0 <= radius_sq && dx1 * dx1 + dy1 * dy1 <= radius_sq))    \
+                continue;                                                                        \
+        } else if (VIEWPORT == VIEWPORT_RECT) {                                                  \
+            if (!(x0 >= rx0 && x0 <= rx1 && y0 >= ry0 && y0 <= ry1 &&                           \
+                  x1 >= rx0 && x1 <= rx1 && y1 >= ry0 && y1 <= ry1))                             \
+                continue;                                                                        \
+        }                                                                                        \
+                                                                                                 \
+        float brightness = (BRIGHTNESS);                                                         \
+        draw_line_f(canvas, x0, y0, x1, y1, VARIABLE ? thickness * brightness : thickness);      \
+    }
+
+#define DEFINE_EDGE_LOOP(NAME, LIGHTING, VIEWPORT, VARIABLE)                                     \
+static void NAME(canvas_t* canvas, const float* xyz, const edge_t* edges, int count,             \
+                 const render_config_t* config) {                                                \
+    EDGE_LOOP_BODY(LIGHTING ? compute_edge_brightness_xyz(p0, p1) : 1.0f, VIEWPORT, VARIABLE)    \
+}
+
+// Lighting already evaluated per edge (shade[i]), e.g. once for several views
+#define DEFINE_SHADED_EDGE_LOOP(NAME, VIEWPORT, VARIABLE)                                        \
+static void NAME(canvas_t* canvas, const float* xyz, const edge_t* edges, int count,             \
+                 const float* shade, const render_config_t* config) {                            \
+    EDGE_LOOP_BODY(shade[i], VIEWPORT, VARIABLE)                                                 \
+}
+
+DEFINE_EDGE_LOOP(edges_plain_none_fixed, 0, VIEWPORT_NONE, 0)
+DEFINE_EDGE_LOOP(edges_plain_none_var, 0, VIEWPORT_NONE, 1)
+DEFINE_EDGE_LOOP(edges_plain_rect_fixed, 0, VIEWPORT_RECT, 0)
+DEFINE_EDGE_LOOP(edges_plain_rect_var, 0, VIEWPORT_RECT, 1)
+DEFINE_EDGE_LOOP(edges_plain_circle_fixed, 0, VIEWPORT_CIRCLE, 0)
+DEFINE_EDGE_LOOP(edges_plain_circle_var, 0, VIEWPORT_CIRCLE, 1)
+DEFINE_EDGE_LOOP(edges_lit_none_fixed, 1, VIEWPORT_NONE, 0)
+DEFINE_EDGE_LOOP(edges_lit_none_var, 1, VIEWPORT_NONE, 1)
+DEFINE_EDGE_LOOP(edges_lit_rect_fixed, 1, VIEWPORT_RECT, 0)
+DEFINE_EDGE_LOOP(edges_lit_rect_var, 1, VIEWPORT_RECT, 1)
+DEFINE_EDGE_LOOP(edges_lit_circle_fixed, 1, VIEWPORT_CIRCLE, 0)
+DEFINE_EDGE_LOOP(edges_lit_circle_var, 1, VIEWPORT_CIRCLE, 1)
+
+// Indexed by [lighting][viewport][variable_thickness]
+static const edge_loop_fn edge_loops[2][3][2] = {
+    {
+        { edges_plain_none_fixed, edges_plain_none_var },
+        { edges_plain_rect_fixed, edges_plain_rect_var },
+        { edges_plain_circle_fixed, edges_plain_circle_var }
+    },
+    {
+        { edges_lit_none_fixed, edges_lit_none_var },
+        { edges_lit_rect_fixed, edges_lit_rect_var },
+        { edges_lit_circle_fixed, edges_lit_circle_var }
+    }
+};
+
+DEFINE_SHADED_EDGE_LOOP(edges_shaded_none_fixed, VIEWPORT_NONE, 0)
+DEFINE_SHADED_EDGE_LOOP(edges_shaded_none_var, VIEWPORT_NONE, 1)
+DEFINE_SHADED_EDGE_LOOP(edges_shaded_rect_fixed, VIEWPORT_RECT, 0)
+DEFINE_SHADED_EDGE_LOOP(edges_shaded_rect_var, VIEWPORT_RECT, 1)
+DEFINE_SHADED_EDGE_LOOP(edges_shaded_circle_fixed, VIEWPORT_CIRCLE, 0)
+DEFINE_SHADED_EDGE_LOOP(edges_shaded_circle_var, VIEWPORT_CIRCLE, 1)
+
+// Indexed by [viewport][variable_thickness]
+static const shaded_edge_loop_fn shaded_edge_loops[3][2] = {
+    { edges_shaded_none_fixed, edges_shaded_none_var },
+    { edges_shaded_rect_fixed, edges_shaded_rect_var },
+    { edges_shaded_circle_fixed, edges_shaded_circle_var }
+};
+
+render_config_t render_config_default() {
+    render_config_t config = {0};
+    config.lighting = 1;
+    config.viewport = VIEWPORT_CIRCLE;
+    config.variable_thickness = 1;
+    config.thickness = 1.5f;
+    return config;
+}
+
+// Pick the specialized loop for a configuration (done once, not per edge)
+render_setup_t render_setup(render_config_t config) {
+    render_setup_t setup;
+    int viewport = config.viewport;
+    if (viewport < VIEWPORT_NONE || viewport > VIEWPORT_CIRCLE) viewport = VIEWPORT_CIRCLE;
+
+    setup.config = config;
+    setup.loop = edge_loops[config.lighting ? 1 : 0][viewport][config.variable_thickness ? 1 : 0];
+    setup.shaded_loop = config.lighting ? shaded_edge_loops[viewport][config.variable_thickness ? 1 : 0] : NULL;
+    return setup;
+}
+
+// Draw edges between packed, already projected xyz points
+void render_edges(canvas_t* canvas, const render_setup_t* setup, const float* xyz,
+                  const edge_t* edges, int count) {
+    setup->loop(canvas, xyz, edges, count, &setup->config);
+}
+
+// Configurable wireframe render. Projects into a scratch buffer, so unlike
+// render_wireframe the mesh vertices are left untouched.
+void render_wireframe_with(canvas_t* canvas, mesh_t* mesh, mat4_t transform, const render_setup_t* setup) {
+    float* projected = malloc(sizeof(float) * 3 * (mesh->vertex_count > 0 ? mesh->vertex_count : 1));
+
+    for (int i = 0; i < mesh->vertex_count; i++) {
+        vec3_t p = mesh->vertices[i].position;
+        float in[3] = { p.x, p.y, p.z };
+        mat4_transform_point(transform, in, &projected[i * 3]);
+    }
+    setup->loop(canvas, projected, mesh->edges, mesh->edge_count, &setup->config);
+
+    free(projected);
+}
+
+// Several cameras, one mesh. The model transform and edge lighting are done once:
+// edges are lit from their world-space direction, so every view (e.g. both eyes
+// of a stereo pair) shades an edge identically. Vertices are then projected in
+// batches, running every view over a batch while its world positions are hot.
+void render_wireframe_views(mesh_t* mesh, mat4_t model, const render_view_t* views, int view_count,
+                            const render_setup_t* setup) {
+    int stride = mesh->vertex_count > 0 ? mesh->vertex_count : 1;
+    float* world = malloc(sizeof(float) * 3 * stride);
+    float* projected = malloc(sizeof(float) * 3 * stride * (view_count > 0 ? view_count : 1));
+
+    for (int start = 0; start < mesh->vertex_count; start += RENDER_VIEW_BATCH) {
+        int end = start + RENDER_VIEW_BATCH < mesh->vertex_count ? start + RENDER_VIEW_BATCH : mesh->vertex_count;
+        for (int i = start; i < end; i++) {
+            vec3_t p = mesh->vertices[i].position;
+            float in[3] = { p.x, p.y, p.z };
+            mat4_transform_point(model, in, &world[i * 3]);
+        }
+        for (int v = 0; v < view_count; v++) {
+            float* out = &projected[(size_t)v * stride * 3];
+            for (int i = start; i < end; i++) {
+                mat4_transform_point(views[v].view_projection, &world[i * 3], &out[i * 3]);
+            }
+        }
+    }
+
+    float* shade = NULL;
+    if (setup->shaded_loop) {
+        shade = malloc(sizeof(float) * (mesh->edge_count > 0 ? mesh->edge_count : 1));
+        for (int i = 0; i < mesh->edge_count; i++) {
+            shade[i] = compute_edge_brightness_xyz(&world[mesh->edges[i].v0 * 3], &world[mesh->edges[i].v1 * 3]);
+        }
+    }
+
+    for (int v = 0; v < view_count; v++) {
+        const float* xyz = &projected[(size_t)v * stride * 3];
+        if (shade) {
+            setup->shaded_loop(views[v].canvas, xyz, mesh->edges, mesh->edge_count, shade, &setup->config);
+        } else {
+            setup->loop(views[v].canvas, xyz, mesh->edges, mesh->edge_count, &setup->config);
+        }
+    }
+
+    free(shade);
+    free(projected);
+    free(world);
+}
+
+// Free memory associated with mesh
+void free_mesh(mesh_t* mesh) {
+    if (mesh) {
+        if (mesh->vertices) free(mesh->vertices);
+        if (mesh->edges) free(mesh->edges);
+        if (mesh->faces) free(mesh->faces);
+        mesh->vertices = NULL;
+        mesh->edges = NULL;
+        mesh->faces = NULL;
+        mesh->vertex_count = 0;
+        mesh->edge_count = 0;
+        mesh->face_count = 0;
+    }
+}
+
+// Main wireframe rendering function (with lighting)
+void render_wireframe(canvas_t* canvas, mesh_t* mesh, mat4_t transform) {
+    // Step 1: Project all vertices
+    for (int i = 0; i < mesh->vertex_count; i++) {
+        project_vertex(&mesh->vertices[i], transform);
+    }
+
+    // Step 2: Draw all edges with lighting
+    for (int i = 0; i < mesh->edge_count; i++) {
+        vertex_t* v0 = &mesh->vertices[mesh->edges[i].v0];
+        vertex_t* v1 = &mesh->vertices[mesh->edges[i].v1];
+
+        // Convert to screen space
+        float x0, y0, x1, y1;
+        ndc_to_screen(canvas, v0->position.x, v0->position.y, &x0, &y0);
+        ndc_to_screen(canvas, v1->position.x, v1->position.y, &x1, &y1);
+
+        if (clip_to_circular_viewport(canvas, x0, y0) &&
+            clip_to_circular_viewport(canvas, x1, y1)) {
+
+            // Compute direction from v0 to v1 for lighting
+            vec3_t edge_dir = vec3_subtract(v1->position, v0->position);
+            float brightness = compute_edge_brightness(edge_dir);
+
+            // Use brightness to scale line thickness or intensity
+            draw_line_f(canvas, x0, y0, x1, y1, 1.5f * brightness);
+        }
+    }
+}
+
+// Hidden-line wireframe: faces are rasterized depth-only first, then edges are
+// drawn with per-sample depth tests. The mesh vertices are left untouched.
+void render_wireframe_hidden(canvas_t* canvas, mesh_t* mesh, mat4_t transform) {
+    float* projected = malloc(sizeof(float) * 3 * (mesh->vertex_count > 0 ? mesh->vertex_count : 1));
+
+    // Step 1: Project all vertices to screen x/y and post-divide z
+    for (int i = 0; i < mesh->vertex_count; i++) {
+        vec3_t p = mesh->vertices[i].position;
+        float in[3] = { p.x, p.y, p.z };
+        float* out = &projected[i * 3];
+        mat4_transform_point(transform, in, out);
+    }
+
+    // Step 2: Depth prepass over faces
+    canvas_enable_depth(canvas);
+    clear_depth(canvas);
+    for (int i = 0; i < mesh->face_count; i++) {
+        const float* a = &projected[mesh->faces[i].v0 * 3];
+        const float* b = &projected[mesh->faces[i].v1 * 3];
+        const float* c = &projected[mesh->faces[i].v2 * 3];
+        float ax, ay, bx, by, cx, cy;
+        ndc_to_screen(canvas, a[0], a[1], &ax, &ay);
+        ndc_to_screen(canvas, b[0], b[1], &bx, &by);
+        ndc_to_screen(canvas, c[0], c[1], &cx, &cy);
+        rasterize_triangle_depth(canvas, ax, ay, a[2], bx, by, b[2], cx, cy, c[2]);
+    }
+
+    // Step 3: Depth-tested edges, same clipping and lighting as render_wireframe
+    for (int i = 0; i < mesh->edge_count; i++) {
+        const float* p0 = &projected[mesh->edges[i].v0 * 3];
+        const float* p1 = &projected[mesh->edges[i].v1 * 3];
+
+        float x0, y0, x1, y1;
+        ndc_to_screen(canvas, p0[0], p0[1], &x0, &y0);
+        ndc_to_screen(canvas, p1[0], p1[1], &x1, &y1);
+
+        if (clip_to_circular_viewport(canvas, x0, y0) &&
+            clip_to_circular_viewport(canvas, x1, y1)) {
+            float brightness = compute_edge_brightness_xyz(p0, p1);
+            draw_line_depth_f(canvas, x0, y0, p0[2], x1, y1, p1[2], 1.5f * brightness, LINE_DEPTH_BIAS);
+        }
+    }
+
+    free(projected);
+}
+
+// Filled, flat-shaded faces. Each face is Lambert-lit from its projected normal
+// (turned towards the viewer), matching how edges are lit from projected
+// directions. Enables the canvas depth buffer; call clear_depth() per frame.
+void render_solid(canvas_t* canvas, mesh_t* mesh, mat4_t transform, light_t* lights, int light_count) {
+    float* projected = malloc(sizeof(float) * 3 * (mesh->vertex_count > 0 ? mesh->vertex_count : 1));
+
+    for (int i = 0; i < mesh->vertex_count; i++) {
+        vec3_t p = mesh->vertices[i].position;
+        float in[3] = { p.x, p.y, p.z };
+        mat4_transform_point(transform, in, &projected[i * 3]);
+    }
+
+    canvas_enable_depth(canvas);
+    for (int i = 0; i < mesh->face_count; i++) {
+        const float* a = &projected[mesh->faces[i].v0 * 3];
+        const float* b = &projected[mesh->faces[i].v1 * 3];
+        const float* c = &projected[mesh->faces[i].v2 * 3];
+
+        vec3_t ab = vec3_from_cartesian(b[0] - a[0], b[1] - a[1], b[2] - a[2]);
+        vec3_t ac = vec3_from_cartesian(c[0] - a[0], c[1] - a[1], c[2] - a[2]);
+        vec3_t normal = vec3_cross(ab, ac);
+        if (normal.z > 0.0f) normal = vec3_scale(normal, -1.0f);
+
+        float shade = compute_lighting_multiple(normal, lights, light_count);
+        if (shade < 0.05f) shade = 0.05f;
+
+        float ax, ay, bx, by, cx, cy;
+        ndc_to_screen(canvas, a[0], a[1], &ax, &ay);
+        ndc_to_screen(canvas, b[0], b[1], &bx, &by);
+        ndc_to_screen(canvas, c[0], c[1], &cx, &cy);
+        fill_triangle_f(canvas, ax, ay, a[2], bx, by, b[2], cx, cy, c[2], shade);
+    }
+
+    free(projected);
+}
+
+// Create a cube mesh centered at origin
+mesh_t create_cube_mesh(float size) {
+    float s = size / 2.0f;
+
+    mesh_t mesh = {0};
+    mesh.vertex_count = 8;
+    mesh.edge_count = 12;
+    mesh.vertices = malloc(sizeof(vertex_t) * mesh.vertex_count);
+    mesh.edges = malloc(sizeof(edge_t) * mesh.edge_count);
+
+    // Cube vertices (same order as your cube wireframe)
+    vec3_t positions[8] = {
+        {-s, -s, -s}, {s, -s, -s}, {s, s, -s}, {-s, s, -s},
+        {-s, -s,  s}, {s, -s,  s}, {s, s,  s}, {-s, s,  s}
+    };
+
+    for (int i = 0; i < 8; i++) {
+        mesh.vertices[i].position = positions[i];
+        mesh.vertices[i].intensity = 1.0f; // optional
+    }
+
+    // Cube edges
+    int edge_indices[12][2] = {
+        {0,1},{1,2},{2,3},{3,0}, // back face
+        {4,5},{5,6},{6,7},{7,4}, // front face
+        {0,4},{1,5},{2,6},{3,7}  // vertical
+    };
+
+    for (int i = 0; i < 12; i++) {
+        mesh.edges[i].v0 = edge_indices[i][0];
+        mesh.edges[i].v1 = edge_indices[i][1];
+        mesh.edges[i].depth = 0.0f; // unused
+    }
+
+    // Cube faces as triangles (used by the depth prepass)
+    int quad_indices[6][4] = {
+        {0,1,2,3}, {4,5,6,7}, // back, front
+        {0,1,5,4}, {3,2,6,7}, // bottom, top
+        {0,3,7,4}, {1,2,6,5}  // left, right
+    };
+
+    mesh.face_count = 12;
+    mesh.faces = malloc(sizeof(face_t) * mesh.face_count);
+    for (int i = 0; i < 6; i++) {
+        mesh.faces[2 * i].v0 = quad_indices[i][0];
+        mesh.faces[2 * i].v1 = quad_indices[i][1];
+        mesh.faces[2 * i].v2 = quad_indices[i][2];
+        mesh.faces[2 * i + 1].v0 = quad_indices[i][0];
+        mesh.faces[2 * i + 1].v1 = quad_indices[i][2];
+        mesh.faces[2 * i + 1].v2 = quad_indices[i][3];
+    }
+
+    return mesh;
+}
+
@@ -0,0 +1,181 @@
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE // memfd_create
+#endif
+#include "sharedcanvas.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Rows padded to whole cache lines so neighbouring rows never share one
+static size_t row_stride(int width) {
+    return (sizeof(float) * (size_t)width + 63) & ~(size_t)63;
+}
+
+_Static_assert(sizeof(shared_canvas_header_t) <= SHARED_CANVAS_HEADER_SIZE,
+               "shared canvas header must fit before the first buffer");
+
+static shared_canvas_t* wrap_mapping(void* mapping, size_t size, int fd, int owns_fd) {
+    shared_canvas_header_t* header = mapping;
+    size_t buffer_size = (size_t)header->stride * header->height;
+
+    shared_canvas_t* shared = malloc(sizeof(shared_canvas_t));
+    for (int i = 0; i < SHARED_CANVAS_BUFFERS; i++) {
+        shared->buffers[i] = create_canvas_external((unsigned char*)mapping + SHARED_CANVAS_HEADER_SIZE +
+                                                    buffer_size * i,
+                                                    (int)header->width, (int)header->height,
+                                                    header->stride, (canvas_format_t)header->format);
+        if (!shared->buffers[i]) {
+            while (i-- > 0) free_canvas(shared->buffers[i]);
+            free(shared);
+            munmap(mapping, size);
+            if (owns_fd) close(fd);
+            return NULL;
+        }
+    }
+    shared->header = header;
+    shared->mapping = mapping;
+    shared->size = size;
+    shared->fd = fd;
+    shared->owns_fd = owns_fd;
+    shared->drawing = -1;
+    shared->held = -1;
+    return shared;
+}
+
+shared_canvas_t* create_shared_canvas(int width, int height, const char* name) {
+    size_t stride = row_stride(width);
+    size_t size = SHARED_CANVAS_HEADER_SIZE + stride * (size_t)height * SHARED_CANVAS_BUFFERS;
+
+    int fd = memfd_create(name ? name : "tiny3d-canvas", MFD_CLOEXEC);
+    if (fd < 0) {
+        perror("memfd_create");
+        return NULL;
+    }
+    if (ftruncate(fd, (off_t)size) != 0) {
+        perror("ftruncate");
+        close(fd);
+        return NULL;
+    }
+
+    void* mapping = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapping == MAP_FAILED) {
+        perror("mmap");
+        close(fd);
+        return NULL;
+    }
+
+    // A fresh memfd reads as zeros, so every buffer starts cleared and frame 0
+    // is a blank canvas in buffer 0
+    shared_canvas_header_t* header = mapping;
+    header->magic = SHARED_CANVAS_MAGIC;
+    header->width = (uint32_t)width;
+    header->height = (uint32_t)height;
+    header->stride = (uint32_t)stride;
+    header->format = CANVAS_FORMAT_F32;
+    header->buffer_count = SHARED_CANVAS_BUFFERS;
+    atomic_init(&header->frame, 0);
+    atomic_init(&header->ready, 0);
+    for (int i = 0; i < SHARED_CANVAS_BUFFERS; i++) {
+        atomic_init(&header->readers[i], 0);
+        header->buffer_frame[i] = 0;
+    }
+
+    return wrap_mapping(mapping, size, fd, 1);
+}
+
+shared_canvas_t* open_shared_canvas(int fd) {
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < SHARED_CANVAS_HEADER_SIZE) {
+        fprintf(stderr, "open_shared_canvas: not a shared canvas\n");
+        return NULL;
+    }
+
+    size_t size = (size_t)st.st_size;
+    void* mapping = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapping == MAP_FAILED) {
+        perror("mmap");
+        return NULL;
+    }
+
+    const shared_canvas_header_t* header = mapping;
+    if (header->magic != SHARED_CANVAS_MAGIC || header->buffer_count != SHARED_CANVAS_BUFFERS ||
+        SHARED_CANVAS_HEADER_SIZE + (size_t)header->stride * header->height * SHARED_CANVAS_BUFFERS > size) {
+        fprintf(stderr, "open_shared_canvas: not a shared canvas\n");
+        munmap(mapping, size);
+        return NULL;
+    }
+    return wrap_mapping(mapping, size, fd, 0);
+}
+
+canvas_t* shared_canvas_begin_frame(shared_canvas_t* shared) {
+    shared_canvas_header_t* header = shared->header;
+    if (shared->drawing >= 0) return shared->buffers[shared->drawing];
+
+    // Only this producer writes ready, so it cannot change under us. A reader
+    // that bumps readers[b] after our check sees ready != b and backs off.
+    unsigned ready = atomic_load_explicit(&header->ready, memory_order_relaxed);
+    for (;;) {
+        for (int i = 1; i < SHARED_CANVAS_BUFFERS; i++) {
+            int b = (int)((ready + i) % SHARED_CANVAS_BUFFERS);
+            if (atomic_load(&header->readers[b]) == 0) {
+                shared->drawing = b;
+                return shared->buffers[b];
+            }
+        }
+        sched_yield();
+    }
+}
+
+unsigned shared_canvas_publish(shared_canvas_t* shared) {
+    shared_canvas_header_t* header = shared->header;
+    if (shared->drawing < 0) return atomic_load_explicit(&header->frame, memory_order_relaxed);
+
+    unsigned frame = atomic_load_explicit(&header->frame, memory_order_relaxed) + 1;
+    header->buffer_frame[shared->drawing] = frame;
+    // Release: the pixel writes and buffer_frame are visible to a reader that sees the new ready
+    atomic_store(&header->ready, (unsigned)shared->drawing);
+    atomic_store_explicit(&header->frame, frame, memory_order_release);
+    shared->drawing = -1;
+    return frame;
+}
+
+const canvas_t* shared_canvas_acquire(shared_canvas_t* shared, unsigned* frame) {
+    shared_canvas_header_t* header = shared->header;
+    if (shared->held < 0) {
+        for (;;) {
+            unsigned b = atomic_load(&header->ready);
+            atomic_fetch_add(&header->readers[b], 1);
+            if (atomic_load(&header->ready) == b) {
+                shared->held = (int)b;
+                break;
+            }
+            atomic_fetch_sub(&header->readers[b], 1);
+        }
+    }
+    if (frame) *frame = header->buffer_frame[shared->held];
+    return shared->buffers[shared->held];
+}
+
+void shared_canvas_release(shared_canvas_t* shared) {
+    if (shared->held < 0) return;
+    // Release: our reads of the buffer finish before the producer may reuse it
+    atomic_fetch_sub_explicit(&shared->header->readers[shared->held], 1, memory_order_release);
+    shared->held = -1;
+}
+
+unsigned shared_canvas_frame(const shared_canvas_t* shared) {
+    return atomic_load_explicit(&shared->header->frame, memory_order_acquire);
+}
+
+void free_shared_canvas(shared_canvas_t* shared) {
+    if (!shared) return;
+    shared_canvas_release(shared);
+    for (int i = 0; i < SHARED_CANVAS_BUFFERS; i++) free_canvas(shared->buffers[i]);
+    munmap(shared->mapping, shared->size);
+    if (shared->owns_fd) close(shared->fd);
+    free(shared);
+}
@@ -0,0 +1,190 @@
+#include "strips.h"
+#include <stdlib.h>
+
+typedef struct {
+    unsigned long long key; // (min << 32) | max
+    int index;              // Position in mesh->edges, ties keep the first occurrence
+} edge_key_t;
+
+static int compare_edge_keys(const void* a, const void* b) {
+    const edge_key_t* ka = a;
+    const edge_key_t* kb = b;
+    if (ka->key != kb->key) return ka->key < kb->key ? -1 : 1;
+    return ka->index - kb->index;
+}
+
+edge_strips_t* build_edge_strips(const mesh_t* mesh) {
+    int n = mesh->edge_count;
+    edge_strips_t* strips = calloc(1, sizeof(edge_strips_t));
+
+    // Step 1: canonical keys, sorted so duplicates are adjacent
+    edge_key_t* keys = malloc(sizeof(edge_key_t) * (n > 0 ? n : 1));
+    int key_count = 0;
+    for (int i = 0; i < n; i++) {
+        unsigned a = (unsigned)mesh->edges[i].v0;
+        unsigned b = (unsigned)mesh->edges[i].v1;
+        if (a == b) continue;
+        if (a > b) { unsigned t = a; a = b; b = t; }
+        keys[key_count].key = ((unsigned long long)a << 32) | b;
+        keys[key_count].index = i;
+        key_count++;
+    }
+    qsort(keys, key_count, sizeof(edge_key_t), compare_edge_keys);
+
+    // Unique edges in their first-seen orientation
+    int* from = malloc(sizeof(int) * (key_count > 0 ? key_count : 1));
+    int* to = malloc(sizeof(int) * (key_count > 0 ? key_count : 1));
+    int unique = 0;
+    for (int i = 0; i < key_count; i++) {
+        if (i > 0 && keys[i].key == keys[i - 1].key) continue;
+        from[unique] = mesh->edges[keys[i].index].v0;
+        to[unique] = mesh->edges[keys[i].index].v1;
+        unique++;
+    }
+    free(keys);
+    strips->edge_count = unique;
+    strips->duplicates_removed = n - unique;
+
+    // Step 2: vertex -> incident edges (CSR)
+    int vc = mesh->vertex_count;
+    int* remaining = calloc(vc + 1, sizeof(int));
+    int* offsets = calloc(vc + 1, sizeof(int));
+    for (int e = 0; e < unique; e++) {
+        remaining[from[e]]++;
+        remaining[to[e]]++;
+    }
+    for (int v = 0; v < vc; v++) offsets[v + 1] = offsets[v] + remaining[v];
+    int* incident = malloc(sizeof(int) * (2 * unique > 0 ? 2 * unique : 1));
+    int* cursor = malloc(sizeof(int) * (vc > 0 ? vc : 1));
+    for (int v = 0; v < vc; v++) cursor[v] = offsets[v];
+    for (int e = 0; e < unique; e++) {
+        incident[cursor[from[e]]++] = e;
+        incident[cursor[to[e]]++] = e;
+    }
+    for (int v = 0; v < vc; v++) cursor[v] = offsets[v];
+
+    // Step 3: greedy walks, odd-degree starts first (a walk from an odd vertex
+    // ends at another odd one), then whatever circuits remain
+    unsigned char* used = calloc(unique > 0 ? unique : 1, 1);
+    int max_strips = unique > 0 ? unique : 1;
+    strips->indices = malloc(sizeof(int) * (unique + max_strips));
+    strips->reversed = calloc(unique + max_strips, 1);
+    strips->starts = malloc(sizeof(int) * (max_strips + 1));
+
+    for (int pass = 0; pass < 2; pass++) {
+        for (int start = 0; start < vc; start++) {
+            while (remaining[start] > 0 && (pass == 1 || (remaining[start] & 1))) {
+                strips->starts[strips->strip_count++] = strips->index_count;
+                strips->indices[strips->index_count++] = start;
+
+                int v = start;
+                for (;;) {
+                    while (cursor[v] < offsets[v + 1] && used[incident[cursor[v]]]) cursor[v]++;
+                    if (cursor[v] == offsets[v + 1]) break;
+
+                    int e = incident[cursor[v]];
+                    used[e] = 1;
+                    remaining[from[e]]--;
+                    remaining[to[e]]--;
+
+                    int next = from[e] == v ? to[e] : from[e];
+                    strips->reversed[strips->index_count] = from[e] != v;
+                    strips->indices[strips->index_count++] = next;
+                    v = next;
+                }
+            }
+        }
+    }
+    strips->starts[strips->strip_count] = strips->index_count;
+
+    free(used);
+    free(cursor);
+    free(incident);
+    free(offsets);
+    free(remaining);
+    free(from);
+    free(to);
+    return strips;
+}
+
+void free_edge_strips(edge_strips_t* strips) {
+    if (strips) {
+        free(strips->indices);
+        free(strips->reversed);
+        free(strips->starts);
+        free(strips);
+    }
+}
+
+static int inside_viewport(canvas_t* canvas, const render_config_t* config, float x, float y) {
+    if (config->viewport == VIEWPORT_CIRCLE) return clip_to_circular_viewport(canvas, x, y);
+    if (config->viewport == VIEWPORT_RECT)
+        return x >= config->rect_x0 && x <= config->rect_x1 && y >= config->rect_y0 && y <= config->rect_y1;
+    return 1;
+}
+
+void render_edge_strips(canvas_t* canvas, const edge_strips_t* strips, mesh_t* mesh,
+                        mat4_t transform, const render_setup_t* setup) {
+    const render_config_t* config = &setup->config;
+    int vc = mesh->vertex_count > 0 ? mesh->vertex_count : 1;
+
+    // Project and map every vertex once
+    float* xyz = malloc(sizeof(float) * 3 * vc);
+    float* screen = malloc(sizeof(float) * 2 * vc);
+    unsigned char* visible = malloc(vc);
+    for (int i = 0; i < mesh->vertex_count; i++) {
+        vec3_t p = mesh->vertices[i].position;
+        float in[3] = { p.x, p.y, p.z };
+        mat4_transform_point(transform, in, &xyz[i * 3]);
+        ndc_to_screen(canvas, xyz[i * 3], xyz[i * 3 + 1], &screen[i * 2], &screen[i * 2 + 1]);
+        visible[i] = (unsigned char)inside_viewport(canvas, config, screen[i * 2], screen[i * 2 + 1]);
+    }
+
+    // Runs of visible segments go to draw_polyline_f; a culled segment splits the run
+    int longest = 2;
+    for (int k = 0; k < strips->strip_count; k++) {
+        int len = strips->starts[k + 1] - strips->starts[k];
+        if (len > longest) longest = len;
+    }
+    float* run_xy = malloc(sizeof(float) * 2 * longest);
+    float* run_thickness = malloc(sizeof(float) * longest);
+
+    for (int k = 0; k < strips->strip_count; k++) {
+        int begin = strips->starts[k];
+        int end = strips->starts[k + 1];
+        int points = 0;
+
+        for (int j = begin + 1; j < end; j++) {
+            int a = strips->indices[j - 1];
+            int b = strips->indices[j];
+            if (!(visible[a] && visible[b])) {
+                draw_polyline_f(canvas, run_xy, points, run_thickness);
+                points = 0;
+                continue;
+            }
+
+            if (points == 0) {
+                run_xy[0] = screen[a * 2];
+                run_xy[1] = screen[a * 2 + 1];
+                points = 1;
+            }
+
+            float brightness = 1.0f;
+            if (config->lighting) {
+                brightness = strips->reversed[j] ? compute_edge_brightness_xyz(&xyz[b * 3], &xyz[a * 3])
+                                                 : compute_edge_brightness_xyz(&xyz[a * 3], &xyz[b * 3]);
+            }
+            run_thickness[points - 1] = config->variable_thickness ? config->thickness * brightness : config->thickness;
+            run_xy[points * 2] = screen[b * 2];
+            run_xy[points * 2 + 1] = screen[b * 2 + 1];
+            points++;
+        }
+        draw_polyline_f(canvas, run_xy, points, run_thickness);
+    }
+
+    free(run_thickness);
+    free(run_xy);
+    free(visible);
+    free(screen);
+    free(xyz);
+}
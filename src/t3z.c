@@ -0,0 +1,286 @@
+#include "t3z.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define T3Z_MAGIC "T3Z1"
+#define T3Z_HEADER_SIZE 12
+#define T3Z_SHORT_RUN 64
+#define T3Z_MAX_LITERALS 62
+
+#define OP_ZERO      0x00
+#define OP_DELTA     0x40
+#define OP_REPEAT    0x80
+#define OP_ZERO_LONG 0xc0
+#define OP_REPEAT_LONG 0xc1
+
+enum { RUN_NONE, RUN_ZERO, RUN_REPEAT };
+
+typedef struct {
+    unsigned char* out;
+    int run_kind;
+    unsigned run;
+    unsigned char literals[T3Z_MAX_LITERALS];
+    int literal_count;
+    int prev;
+} t3z_encoder_t;
+
+static void put_u32(unsigned char* p, unsigned v) {
+    p[0] = v & 0xff;
+    p[1] = (v >> 8) & 0xff;
+    p[2] = (v >> 16) & 0xff;
+    p[3] = (v >> 24) & 0xff;
+}
+
+static unsigned get_u32(const unsigned char* p) {
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((unsigned)p[3] << 24);
+}
+
+static void flush_run(t3z_encoder_t* e) {
+    if (e->run_kind == RUN_NONE) return;
+    if (e->run <= T3Z_SHORT_RUN) {
+        *e->out++ = (unsigned char)((e->run_kind == RUN_ZERO ? OP_ZERO : OP_REPEAT) | (e->run - 1));
+    } else {
+        *e->out++ = e->run_kind == RUN_ZERO ? OP_ZERO_LONG : OP_REPEAT_LONG;
+        unsigned v = e->run - 1;
+        while (v >= 0x80) {
+            *e->out++ = (unsigned char)(v | 0x80);
+            v >>= 7;
+        }
+        *e->out++ = (unsigned char)v;
+    }
+    e->run_kind = RUN_NONE;
+    e->run = 0;
+}
+
+static void flush_literals(t3z_encoder_t* e) {
+    if (!e->literal_count) return;
+    *e->out++ = (unsigned char)(0xc0 | (e->literal_count + 1));
+    memcpy(e->out, e->literals, e->literal_count);
+    e->out += e->literal_count;
+    e->literal_count = 0;
+}
+
+size_t canvas_t3z_max_size(canvas_t* canvas) {
+    // Every op covers at least one pixel and carries at most one byte per pixel
+    size_t pixels = (size_t)canvas->width * canvas->height;
+    return T3Z_HEADER_SIZE + pixels * 2;
+}
+
+static void encode_span(t3z_encoder_t* e, const float* row, int n) {
+    for (int x = 0; x < n; x++) {
+        if (e->run_kind == RUN_ZERO && row[x] == 0.0f) {
+            // Untouched background: extend the run without quantizing
+            int start = x;
+            while (x + 1 < n && row[x + 1] == 0.0f) x++;
+            e->run += (unsigned)(x - start + 1);
+            continue;
+        }
+
+        int v = (unsigned char)(fminf(row[x], 1.0f) * 255);
+
+        if (e->run_kind == RUN_ZERO && v == 0) { e->run++; continue; }
+        if (e->run_kind == RUN_REPEAT && v == e->prev) { e->run++; continue; }
+        flush_run(e);
+
+        if (v == 0 || v == e->prev) {
+            flush_literals(e);
+            e->run_kind = v == 0 ? RUN_ZERO : RUN_REPEAT;
+            e->run = 1;
+        } else if (v - e->prev >= -32 && v - e->prev <= 31 && e->literal_count == 0) {
+            *e->out++ = (unsigned char)(OP_DELTA | (v - e->prev + 32));
+        } else {
+            // Inside a literal group a delta-codable pixel costs the same byte
+            e->literals[e->literal_count++] = (unsigned char)v;
+            if (e->literal_count == T3Z_MAX_LITERALS) flush_literals(e);
+        }
+        e->prev = v;
+    }
+}
+
+// n pixels of an untouched sparse tile row
+static void encode_zeros(t3z_encoder_t* e, int n) {
+    if (e->run_kind != RUN_ZERO) {
+        flush_run(e);
+        flush_literals(e);
+        e->run_kind = RUN_ZERO;
+        e->run = 0;
+    }
+    e->run += (unsigned)n;
+    e->prev = 0;
+}
+
+size_t encode_canvas_as_t3z(canvas_t* canvas, unsigned char* out) {
+    if (canvas->width > T3Z_MAX_DIMENSION || canvas->height > T3Z_MAX_DIMENSION) return 0;
+
+    memcpy(out, T3Z_MAGIC, 4);
+    put_u32(out + 4, (unsigned)canvas->width);
+    put_u32(out + 8, (unsigned)canvas->height);
+
+    t3z_encoder_t e = { out + T3Z_HEADER_SIZE, RUN_NONE, 0, {0}, 0, 0 };
+
+    for (int y = 0; y < canvas->height; y++) {
+        if (!canvas->tiles) {
+            encode_span(&e, canvas->pixels[y], canvas->width);
+            continue;
+        }
+        const float* const* tiles = (const float* const*)&canvas->tiles[(y / CANVAS_TILE_SIZE) * canvas->tiles_x];
+        int offset = (y % CANVAS_TILE_SIZE) * CANVAS_TILE_SIZE;
+        for (int tx = 0; tx < canvas->tiles_x; tx++) {
+            int n = canvas->width - tx * CANVAS_TILE_SIZE;
+            if (n > CANVAS_TILE_SIZE) n = CANVAS_TILE_SIZE;
+            if (tiles[tx]) {
+                encode_span(&e, tiles[tx] + offset, n);
+            } else {
+                encode_zeros(&e, n);
+            }
+        }
+    }
+    flush_run(&e);
+    flush_literals(&e);
+    return (size_t)(e.out - out);
+}
+
+void save_canvas_as_t3z(canvas_t* canvas, const char* filename) {
+    if (canvas->width > T3Z_MAX_DIMENSION || canvas->height > T3Z_MAX_DIMENSION) {
+        fprintf(stderr, "T3Z frames are limited to %dx%d pixels\n", T3Z_MAX_DIMENSION, T3Z_MAX_DIMENSION);
+        return;
+    }
+
+    unsigned char* data = malloc(canvas_t3z_max_size(canvas));
+    size_t size = encode_canvas_as_t3z(canvas, data);
+
+    FILE* file = fopen(filename, "wb");
+    if (!file) {
+        perror("Failed to open file");
+        free(data);
+        return;
+    }
+    fwrite(data, 1, size, file);
+    fclose(file);
+    free(data);
+}
+
+// Walk the op stream; with pixels NULL only check that it covers exactly total
+// pixels. Returns 1 if it does (and every op is well formed).
+static int decode_ops(const unsigned char* p, const unsigned char* end, unsigned char* pixels, size_t total) {
+    size_t i = 0;
+    unsigned char prev = 0;
+
+    while (i < total) {
+        if (p >= end) return 0;
+        unsigned op = *p++;
+        size_t run = 0;
+        unsigned char value = prev;
+
+        switch (op & 0xc0) {
+            case OP_ZERO:
+                run = (op & 0x3f) + 1;
+                value = 0;
+                break;
+            case OP_DELTA:
+                run = 1;
+                value = (unsigned char)(prev + (int)(op & 0x3f) - 32);
+                break;
+            case OP_REPEAT:
+                run = (op & 0x3f) + 1;
+                break;
+            default:
+                if (op == OP_ZERO_LONG || op == OP_REPEAT_LONG) {
+                    size_t v = 0;
+                    int shift = 0;
+                    for (;;) {
+                        if (p >= end || shift > 35) return 0;
+                        unsigned b = *p++;
+                        v |= (size_t)(b & 0x7f) << shift;
+                        shift += 7;
+                        if (!(b & 0x80)) break;
+                    }
+                    run = v + 1;
+                    if (op == OP_ZERO_LONG) value = 0;
+                } else {
+                    size_t n = (op & 0x3f) - 1;
+                    if (n > (size_t)(end - p) || n > total - i) return 0;
+                    if (pixels) memcpy(pixels + i, p, n);
+                    p += n;
+                    i += n;
+                    prev = p[-1];
+                    continue;
+                }
+                break;
+        }
+
+        if (run > total - i) return 0;
+        if (pixels) memset(pixels + i, value, run);
+        i += run;
+        prev = value;
+    }
+    return 1;
+}
+
+unsigned char* decode_t3z(const unsigned char* data, size_t size, int* width, int* height) {
+    if (size < T3Z_HEADER_SIZE || memcmp(data, T3Z_MAGIC, 4) != 0) return NULL;
+    unsigned w = get_u32(data + 4);
+    unsigned h = get_u32(data + 8);
+    if (w > T3Z_MAX_DIMENSION || h > T3Z_MAX_DIMENSION) return NULL;
+
+    // Check the ops cover the declared size before allocating for it, so a
+    // bare header cannot make us allocate gigabytes
+    size_t total = (size_t)w * h;
+    const unsigned char* ops = data + T3Z_HEADER_SIZE;
+    if (!decode_ops(ops, data + size, NULL, total)) return NULL;
+
+    unsigned char* pixels = malloc(total > 0 ? total : 1);
+    if (!pixels) {
+        fprintf(stderr, "decode_t3z: out of memory for %ux%u pixels\n", w, h);
+        return NULL;
+    }
+    decode_ops(ops, data + size, pixels, total);
+
+    *width = (int)w;
+    *height = (int)h;
+    return pixels;
+}
+
+canvas_t* load_canvas_t3z(const char* filename) {
+    FILE* file = fopen(filename, "rb");
+    if (!file) {
+        perror("Failed to open file");
+        return NULL;
+    }
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    if (size < 0) {
+        fclose(file);
+        return NULL;
+    }
+
+    unsigned char* data = malloc(size > 0 ? (size_t)size : 1);
+    size_t got = fread(data, 1, (size_t)size, file);
+    fclose(file);
+
+    int width, height;
+    unsigned char* pixels = decode_t3z(data, got, &width, &height);
+    free(data);
+    if (!pixels) {
+        fprintf(stderr, "Not a valid T3Z file: %s\n", filename);
+        return NULL;
+    }
+
+    canvas_t* canvas = create_canvas(width, height);
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            canvas->pixels[y][x] = pixels[(size_t)y * width + x] / 255.0f;
+        }
+    }
+    free(pixels);
+    return canvas;
+}
+
+int is_t3z_filename(const char* filename) {
+    size_t len = strlen(filename);
+    size_t ext = strlen(T3Z_EXTENSION);
+    return len >= ext && strcmp(filename + len - ext, T3Z_EXTENSION) == 0;
+}
@@ -0,0 +1,78 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "renderer.h"
+#include "displaylist.h"
+
+#define LIST_FILE "test_displaylist.t3dl"
+#define BAD_FILE "test_displaylist_bad.t3dl"
+
+// Write a header ("T3DL", version 1, count) followed by segment_count zeroed segments
+static void write_list_file(const char* filename, int count, int segment_count) {
+    FILE* file = fopen(filename, "wb");
+    int version = 1;
+    display_segment_t zero = {0};
+    fwrite("T3DL", 1, 4, file);
+    fwrite(&version, sizeof(int), 1, file);
+    fwrite(&count, sizeof(int), 1, file);
+    for (int i = 0; i < segment_count; i++) fwrite(&zero, sizeof(zero), 1, file);
+    fclose(file);
+}
+
+static int check_round_trip() {
+    mesh_t cube = create_cube_mesh(1.0f);
+    display_list_t* list = create_display_list();
+    display_list_record(list, &cube, mat4_rotate_xyz(0.3f, 0.5f, 0.1f));
+    display_list_record(list, &cube, mat4_rotate_xyz(1.0f, 0.2f, 0.7f));
+    display_list_sort(list);
+
+    int failures = 0;
+    if (!save_display_list(list, LIST_FILE)) failures++;
+    display_list_t* loaded = load_display_list(LIST_FILE);
+    if (!loaded || loaded->count != list->count ||
+        memcmp(loaded->segments, list->segments, sizeof(display_segment_t) * list->count) != 0) {
+        fprintf(stderr, "Display list round trip mismatch\n");
+        failures++;
+    }
+
+    free_display_list(loaded);
+    free_display_list(list);
+    free_mesh(&cube);
+    remove(LIST_FILE);
+    return failures;
+}
+
+// Headers whose count the payload cannot back must be rejected without allocating for it
+static int check_bad_headers() {
+    struct { int count; int segments; } cases[] = {
+        { 5, 2 },           // Truncated payload
+        { 1073741825, 0 },  // Would overflow the capacity doubling
+        { 0x7fffffff, 1 },  // Huge count, tiny file
+        { -1, 0 }           // Negative count
+    };
+    int failures = 0;
+    for (int i = 0; i < (int)(sizeof(cases) / sizeof(cases[0])); i++) {
+        write_list_file(BAD_FILE, cases[i].count, cases[i].segments);
+        display_list_t* list = load_display_list(BAD_FILE);
+        if (list) {
+            fprintf(stderr, "Accepted display list with count %d and %d segments\n",
+                    cases[i].count, cases[i].segments);
+            free_display_list(list);
+            failures++;
+        }
+    }
+
+    // An exact payload still loads
+    write_list_file(BAD_FILE, 3, 3);
+    display_list_t* list = load_display_list(BAD_FILE);
+    if (!list || list->count != 3) failures++;
+    free_display_list(list);
+    remove(BAD_FILE);
+    return failures;
+}
+
+int main() {
+    int failures = check_round_trip() + check_bad_headers();
+    printf("display list tests: %s\n", failures ? "FAILED" : "passed");
+    return failures ? 1 : 0;
+}
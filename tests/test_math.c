@@ -1,80 +1,162 @@
-#include <stdio.h>
-#include <stdlib.h>
-#include <math.h>
-#include "math3d.h"
-#include "canvas.h"
-
-#define WIDTH 800
-#define HEIGHT 600
-#define CENTER_X (WIDTH/2.0f)
-#define CENTER_Y (HEIGHT/2.0f)
-
-// Cube vertices (8 corners)
-vec3_t cube_vertices[] = {
-    {-1, -1, -1},  // 0
-    { 1, -1, -1},  // 1
-    { 1,  1, -1},  // 2
-    {-1,  1, -1},  // 3
-    {-1, -1,  1},  // 4
-    { 1, -1,  1},  // 5
-    { 1,  1,  1},  // 6
-    {-1,  1,  1}   // 7
-};
-
-// Cube edges (12 edges connecting the vertices)
-int cube_edges[][2] = {
-    {0, 1}, {1, 2}, {2, 3}, {3, 0}, // Bottom face
-    {4, 5}, {5, 6}, {6, 7}, {7, 4}, // Top face
-    {0, 4}, {1, 5}, {2, 6}, {3, 7}  // Vertical edges
-};
-
-void draw_cube(canvas_t* canvas, mat4_t transform) {
-    vec3_t projected[8];
-    for (int i = 0; i < 8; i++) {
-        vec3_t transformed = mat4_transform_vec3(transform, cube_vertices[i]);
-        float z = transformed.z + 5.0f;
-        projected[i].x = transformed.x / z * 200.0f + CENTER_X;
-        projected[i].y = transformed.y / z * 200.0f + CENTER_Y;
-    }
-
-    for (int i = 0; i < 12; i++) {
-        int v0 = cube_edges[i][0];
-        int v1 = cube_edges[i][1];
-        draw_line_f(canvas, 
-                   projected[v0].x, projected[v0].y,
-                   projected[v1].x, projected[v1].y,
-                   1.5f);
-    }
-}
-
-int main() {
-    canvas_t* canvas = create_canvas(WIDTH, HEIGHT);
-    
-    const int num_frames = 60;
-    for (int frame = 0; frame < num_frames; frame++) {
-        float angle = (2.0f * M_PI * frame) / num_frames;  // Full 360° rotation
-        mat4_t rotation = mat4_rotate_xyz(0.0f, angle, 0.0f);  // Rotate around Y-axis
-        mat4_t translation = mat4_translate(0.0f, 0.0f, 0.0f);
-        mat4_t transform = mat4_multiply(translation, rotation);
-        
-        // Clear canvas
-        for (int y = 0; y < HEIGHT; y++) {
-            for (int x = 0; x < WIDTH; x++) {
-                canvas->pixels[y][x] = 0.0f;
-            }
-        }
-
-        draw_cube(canvas, transform);
-
-        char filename[64];
-        sprintf(filename, "frame_%02d.ppm", frame);
-        save_canvas_as_ppm(canvas, filename);
-        
-        printf("Saved %s\n", filename);
-    }
-    
-    free_canvas(canvas);
-    printf("All frames saved.\n");
-    
-    return 0;
-}
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "math3d.h"
+#include "canvas.h"
+#include "fastmath.h"
+
+#define WIDTH 800
+#define HEIGHT 600
+#define CENTER_X (WIDTH/2.0f)
+#define CENTER_Y (HEIGHT/2.0f)
+
+// Cube vertices (8 corners)
+vec3_t cube_vertices[] = {
+    {-1, -1, -1},  // 0
+    { 1, -1, -1},  // 1
+    { 1,  1, -1},  // 2
+    {-1,  1, -1},  // 3
+    {-1, -1,  1},  // 4
+    { 1, -1,  1},  // 5
+    { 1,  1,  1},  // 6
+    {-1,  1,  1}   // 7
+};
+
+// Cube edges (12 edges connecting the vertices)
+int cube_edges[][2] = {
+    {0, 1}, {1, 2}, {2, 3}, {3, 0}, // Bottom face
+    {4, 5}, {5, 6}, {6, 7}, {7, 4}, // Top face
+    {0, 4}, {1, 5}, {2, 6}, {3, 7}  // Vertical edges
+};
+
+// Accuracy bounds of the fast-math layer (must match fastmath.h)
+#define SINCOS_MAX_ERR 2e-7
+#define ACOS_MAX_ERR 4e-7
+#define ATAN2_MAX_ERR 3e-7
+#define ACCURACY_SAMPLES 1000000
+
+// Compare fastmath.h against double-precision libm; returns number of failures
+int check_fast_math_accuracy() {
+    double err_sin = 0, err_cos = 0, err_acos = 0, err_atan2 = 0, err_array = 0, err_atan2_array = 0;
+    static float xs[1024], ss[1024], cs[1024], ys[1024], as[1024];
+
+    for (int i = 0; i <= ACCURACY_SAMPLES; i++) {
+        float x = -FAST_TRIG_MAX_ARG + 2.0f * FAST_TRIG_MAX_ARG * i / ACCURACY_SAMPLES;
+        float s, c;
+        fast_sincosf(x, &s, &c);
+        err_sin = fmax(err_sin, fabs(s - sin((double)x)));
+        err_cos = fmax(err_cos, fabs(c - cos((double)x)));
+    }
+
+    for (int i = 0; i <= ACCURACY_SAMPLES; i++) {
+        float x = -1.0f + 2.0f * i / ACCURACY_SAMPLES;
+        err_acos = fmax(err_acos, fabs(fast_acosf(x) - acos((double)x)));
+    }
+
+    // Walk a spiral so every quadrant and ratio is covered
+    for (int i = 0; i < ACCURACY_SAMPLES; i++) {
+        float angle = 40.0f * (float)M_PI * i / ACCURACY_SAMPLES;
+        float radius = 1e-3f + 1e3f * i / ACCURACY_SAMPLES;
+        float y = radius * sinf(angle), x = radius * cosf(angle);
+        err_atan2 = fmax(err_atan2, fabs(fast_atan2f(y, x) - atan2((double)y, (double)x)));
+    }
+
+    for (int i = 0; i < 1024; i++) xs[i] = -100.0f + 200.0f * i / 1023;
+    fast_sincosf_array(xs, ss, cs, 1024);
+    for (int i = 0; i < 1024; i++) {
+        err_array = fmax(err_array, fabs(ss[i] - sin((double)xs[i])));
+        err_array = fmax(err_array, fabs(cs[i] - cos((double)xs[i])));
+    }
+
+    // Axes, diagonals and signed zeros first, then the same spiral as the scalar check
+    static const float special[][2] = {
+        { 0.0f,  0.0f}, {-0.0f,  0.0f}, { 0.0f, -0.0f}, {-0.0f, -0.0f},
+        { 0.0f,  1.0f}, {-0.0f,  1.0f}, { 0.0f, -1.0f}, {-0.0f, -1.0f},
+        { 1.0f,  0.0f}, { 1.0f, -0.0f}, {-1.0f,  0.0f}, {-1.0f, -0.0f},
+        { 1.0f,  1.0f}, { 1.0f, -1.0f}, {-1.0f,  1.0f}, {-1.0f, -1.0f}
+    };
+    int special_count = sizeof(special) / sizeof(special[0]);
+    for (int i = 0; i < 1024; i++) {
+        if (i < special_count) {
+            ys[i] = special[i][0];
+            xs[i] = special[i][1];
+        } else {
+            float angle = 40.0f * (float)M_PI * i / 1024;
+            float radius = 1e-3f + 1e3f * i / 1024;
+            ys[i] = radius * sinf(angle);
+            xs[i] = radius * cosf(angle);
+        }
+    }
+    fast_atan2f_array(ys, xs, as, 1024);
+    for (int i = 0; i < 1024; i++) {
+        err_atan2_array = fmax(err_atan2_array, fabs(as[i] - atan2((double)ys[i], (double)xs[i])));
+    }
+
+    printf("fast math max error: sin %.3g cos %.3g acos %.3g atan2 %.3g sincos[] %.3g atan2[] %.3g\n",
+           err_sin, err_cos, err_acos, err_atan2, err_array, err_atan2_array);
+
+    int failures = 0;
+    if (err_sin > SINCOS_MAX_ERR) failures++;
+    if (err_cos > SINCOS_MAX_ERR) failures++;
+    if (err_acos > ACOS_MAX_ERR) failures++;
+    if (err_atan2 > ATAN2_MAX_ERR) failures++;
+    if (err_array > SINCOS_MAX_ERR) failures++;
+    if (err_atan2_array > ATAN2_MAX_ERR) failures++;
+    return failures;
+}
+
+void draw_cube(canvas_t* canvas, mat4_t transform) {
+    vec3_t projected[8];
+    for (int i = 0; i < 8; i++) {
+        vec3_t transformed = mat4_transform_vec3(transform, cube_vertices[i]);
+        float z = transformed.z + 5.0f;
+        projected[i].x = transformed.x / z * 200.0f + CENTER_X;
+        projected[i].y = transformed.y / z * 200.0f + CENTER_Y;
+    }
+
+    for (int i = 0; i < 12; i++) {
+        int v0 = cube_edges[i][0];
+        int v1 = cube_edges[i][1];
+        draw_line_f(canvas, 
+                   projected[v0].x, projected[v0].y,
+                   projected[v1].x, projected[v1].y,
+                   1.5f);
+    }
+}
+
+int main() {
+    if (check_fast_math_accuracy() != 0) {
+        fprintf(stderr, "Fast math accuracy check failed\n");
+        return 1;
+    }
+
+    canvas_t* canvas = create_canvas(WIDTH, HEIGHT);
+    
+    const int num_frames = 60;
+    for (int frame = 0; frame < num_frames; frame++) {
+        float angle = (2.0f * M_PI * frame) / num_frames;  // Full 360° rotation
+        mat4_t rotation = mat4_rotate_xyz(0.0f, angle, 0.0f);  // Rotate around Y-axis
+        mat4_t translation = mat4_translate(0.0f, 0.0f, 0.0f);
+        mat4_t transform = mat4_multiply(translation, rotation);
+        
+        // Clear canvas
+        for (int y = 0; y < HEIGHT; y++) {
+            for (int x = 0; x < WIDTH; x++) {
+                canvas->pixels[y][x] = 0.0f;
+            }
+        }
+
+        draw_cube(canvas, transform);
+
+        char filename[64];
+        sprintf(filename, "frame_%02d.ppm", frame);
+        save_canvas_as_ppm(canvas, filename);
+        
+        printf("Saved %s\n", filename);
+    }
+    
+    free_canvas(canvas);
+    printf("All frames saved.\n");
+    
+    return 0;
+}
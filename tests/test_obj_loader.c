@@ -0,0 +1,89 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "renderer.h"
+
+#define OBJ_FILE "test_obj_loader.obj"
+#define TARGET_BYTES (1024 * 1024) // Well above the parallel loader's 256 KiB minimum chunk
+
+static unsigned rng_state = 12345;
+static unsigned next_random() {
+    rng_state = rng_state * 1103515245u + 12345u;
+    return (rng_state >> 16) & 0x7fff;
+}
+
+// Write an OBJ mixing every record shape the loaders must agree on: absolute,
+// relative, zero, forward and out-of-range indices, v/vt/vn references, CRLF
+// line ends, comments, other records, and no newline after the last line.
+static long write_test_obj(const char* filename) {
+    FILE* file = fopen(filename, "wb");
+    if (!file) return -1;
+
+    int vertices = 0;
+    long bytes = 0;
+    while (bytes < TARGET_BYTES) {
+        const char* eol = next_random() % 5 == 0 ? "\r\n" : "\n";
+        int kind = next_random() % 10;
+        if (kind < 5 || vertices < 4) {
+            bytes += fprintf(file, "v %.4f %.4f %.4f%s", (next_random() % 2000) / 1000.0f - 1.0f,
+                             (next_random() % 2000) / 1000.0f - 1.0f,
+                             (next_random() % 2000) / 1000.0f - 1.0f, eol);
+            vertices++;
+        } else if (kind == 5) {
+            bytes += fprintf(file, "f %d/%d/%d %d//%d %d%s", vertices, vertices, vertices,
+                             vertices - 1, vertices - 1, vertices - 2, eol);
+        } else if (kind == 6) {
+            bytes += fprintf(file, "f -1 -2 -3 -4%s", eol);
+        } else if (kind == 7) {
+            // Zero, forward and out-of-range indices
+            int forward = vertices + 1 + (int)(next_random() % 8);
+            bytes += fprintf(file, "f %d %d 0 %d%s", vertices, forward, -(vertices + 5), eol);
+        } else if (kind == 8) {
+            // Polygon longer than the 32-index limit
+            bytes += fprintf(file, "f");
+            for (int i = 0; i < 40; i++) bytes += fprintf(file, " %d", 1 + (int)(next_random() % vertices));
+            bytes += fprintf(file, "%s", eol);
+        } else {
+            bytes += fprintf(file, "%s%s", next_random() % 2 ? "# comment" : "vn 0 0 1", eol);
+        }
+    }
+    bytes += fprintf(file, "f 1 2 3");
+    fclose(file);
+    return bytes;
+}
+
+static int same_mesh(const mesh_t* a, const mesh_t* b) {
+    return a->vertex_count == b->vertex_count && a->edge_count == b->edge_count &&
+           a->face_count == b->face_count &&
+           memcmp(a->vertices, b->vertices, sizeof(vertex_t) * a->vertex_count) == 0 &&
+           memcmp(a->edges, b->edges, sizeof(edge_t) * a->edge_count) == 0 &&
+           memcmp(a->faces, b->faces, sizeof(face_t) * a->face_count) == 0;
+}
+
+int main() {
+    long bytes = write_test_obj(OBJ_FILE);
+    if (bytes < 0) {
+        perror("Failed to write test OBJ");
+        return 1;
+    }
+
+    mesh_t serial = load_obj_mesh(OBJ_FILE);
+    printf("%ld bytes: %d vertices, %d edges, %d faces\n", bytes,
+           serial.vertex_count, serial.edge_count, serial.face_count);
+
+    int failures = 0;
+    int thread_counts[] = { 1, 2, 3, 4, 7, 16, 64, 0 };
+    for (int i = 0; i < (int)(sizeof(thread_counts) / sizeof(thread_counts[0])); i++) {
+        mesh_t parallel = load_obj_mesh_parallel(OBJ_FILE, thread_counts[i]);
+        if (!same_mesh(&serial, &parallel)) {
+            fprintf(stderr, "Parallel load with %d threads differs from the serial load\n", thread_counts[i]);
+            failures++;
+        }
+        free_mesh(&parallel);
+    }
+
+    free_mesh(&serial);
+    remove(OBJ_FILE);
+    printf("OBJ loader tests: %s\n", failures ? "FAILED" : "passed");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,89 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "renderer.h"
+#include "sharedcanvas.h"
+
+#define WIDTH 256
+#define HEIGHT 192
+#define FRAMES 500
+
+// Producer: frames 1..FRAMES-1 are filled with their own frame number so a torn
+// read shows up as mixed values; the last frame is a rendered cube.
+static void produce(shared_canvas_t* shared, mesh_t* cube, mat4_t transform, const render_setup_t* setup) {
+    for (int n = 1; n < FRAMES; n++) {
+        canvas_t* canvas = shared_canvas_begin_frame(shared);
+        for (int y = 0; y < HEIGHT; y++) {
+            for (int x = 0; x < WIDTH; x++) canvas->pixels[y][x] = (float)n;
+        }
+        shared_canvas_publish(shared);
+    }
+    canvas_t* canvas = shared_canvas_begin_frame(shared);
+    clear_canvas(canvas, 0.0f);
+    render_wireframe_with(canvas, cube, transform, setup);
+    shared_canvas_publish(shared);
+}
+
+// Reader: every held frame must be uniform and frame numbers must not go back
+static int consume(shared_canvas_t* view, const canvas_t* reference) {
+    int failures = 0, reads = 0;
+    unsigned last = 0, frame = 0;
+    while (frame < FRAMES) {
+        const canvas_t* canvas = shared_canvas_acquire(view, &frame);
+        if (frame < last) failures++;
+        if (frame > 0 && frame < FRAMES) {
+            for (int y = 0; y < HEIGHT; y++) {
+                for (int x = 0; x < WIDTH; x++) {
+                    if (canvas->pixels[y][x] != (float)frame) {
+                        failures++;
+                        y = HEIGHT;
+                        break;
+                    }
+                }
+            }
+        } else if (frame == FRAMES) {
+            for (int y = 0; y < HEIGHT; y++) {
+                if (memcmp(canvas->pixels[y], reference->pixels[y], sizeof(float) * WIDTH) != 0) failures++;
+            }
+        }
+        last = frame;
+        reads++;
+        shared_canvas_release(view);
+    }
+    printf("shared canvas: %d reads, last frame %u, %d torn or mismatched\n", reads, frame, failures);
+    return failures;
+}
+
+int main() {
+    mesh_t cube = create_cube_mesh(1.0f);
+    mat4_t transform = mat4_rotate_xyz(0.4f, 0.7f, 0.1f);
+    render_setup_t setup = render_setup(render_config_default());
+
+    canvas_t* reference = create_canvas(WIDTH, HEIGHT);
+    render_wireframe_with(reference, &cube, transform, &setup);
+
+    shared_canvas_t* shared = create_shared_canvas(WIDTH, HEIGHT, "test_sharedcanvas");
+    if (!shared) return 1;
+
+    pid_t pid = fork();
+    if (pid == 0) {
+        produce(shared, &cube, transform, &setup);
+        _exit(0);
+    }
+
+    // A separate mapping of the same memfd, as another process would open it
+    shared_canvas_t* view = open_shared_canvas(shared->fd);
+    int failures = view ? consume(view, reference) : 1;
+    int status = 0;
+    waitpid(pid, &status, 0);
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) failures++;
+
+    free_shared_canvas(view);
+    free_shared_canvas(shared);
+    free_canvas(reference);
+    free_mesh(&cube);
+    printf("shared canvas tests: %s\n", failures ? "FAILED" : "passed");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,83 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "renderer.h"
+#include "t3z.h"
+
+#define WIDTH 300
+#define HEIGHT 200
+
+// Encode, decode, and compare with the canvas quantized as save_canvas_as_ppm does
+static int check_round_trip(canvas_t* canvas, const char* label) {
+    unsigned char* data = malloc(canvas_t3z_max_size(canvas));
+    size_t size = encode_canvas_as_t3z(canvas, data);
+
+    int width = 0, height = 0;
+    unsigned char* pixels = decode_t3z(data, size, &width, &height);
+    int failures = 0;
+    if (!pixels || width != canvas->width || height != canvas->height) {
+        failures++;
+    } else {
+        float* scratch = malloc(sizeof(float) * canvas->width);
+        for (int y = 0; y < height; y++) {
+            const float* row = canvas_row(canvas, y, scratch);
+            for (int x = 0; x < width; x++) {
+                if (pixels[(size_t)y * width + x] != (unsigned char)(fminf(row[x], 1.0f) * 255)) failures++;
+            }
+        }
+        free(scratch);
+    }
+    printf("%s: %zu bytes, %s\n", label, size, failures ? "MISMATCH" : "round trip ok");
+
+    free(pixels);
+    free(data);
+    return failures ? 1 : 0;
+}
+
+// Inputs that must be refused without allocating for the declared size
+static int check_limits() {
+    int failures = 0;
+
+    canvas_t* wide = create_sparse_canvas(T3Z_MAX_DIMENSION + 1, 10, NULL);
+    unsigned char header[64];
+    if (encode_canvas_as_t3z(wide, header) != 0) failures++;
+    free_canvas(wide);
+
+    // Bare header declaring the largest frame, and one with a single short run
+    unsigned char bare[13] = { 'T', '3', 'Z', '1', 0, 0, 1, 0, 0, 0, 1, 0, 0x3f };
+    int width, height;
+    if (decode_t3z(bare, 12, &width, &height)) failures++;
+    if (decode_t3z(bare, 13, &width, &height)) failures++;
+
+    // Oversized dimension
+    bare[6] = 2;
+    if (decode_t3z(bare, 12, &width, &height)) failures++;
+
+    printf("limits: %s\n", failures ? "FAILED" : "ok");
+    return failures;
+}
+
+int main() {
+    mesh_t cube = create_cube_mesh(1.0f);
+    render_setup_t setup = render_setup(render_config_default());
+    mat4_t transform = mat4_rotate_xyz(0.4f, 0.7f, 0.1f);
+    int failures = 0;
+
+    canvas_t* dense = create_canvas(WIDTH, HEIGHT);
+    render_wireframe_with(dense, &cube, transform, &setup);
+    for (int x = 0; x < WIDTH; x++) dense->pixels[HEIGHT - 1][x] = x / (float)WIDTH; // Deltas and literals
+    failures += check_round_trip(dense, "dense");
+
+    canvas_t* sparse = create_sparse_canvas(WIDTH, HEIGHT, NULL);
+    render_wireframe_with(sparse, &cube, transform, &setup);
+    failures += check_round_trip(sparse, "sparse");
+
+    failures += check_limits();
+
+    free_canvas(dense);
+    free_canvas(sparse);
+    free_mesh(&cube);
+    printf("T3Z tests: %s\n", failures ? "FAILED" : "passed");
+    return failures ? 1 : 0;
+}